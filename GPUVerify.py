@@ -2,13 +2,17 @@
 # vim: set shiftwidth=2 tabstop=2 expandtab softtabstop=2:
 from __future__ import print_function
 
+import hashlib
 import pickle
+import json
 import os
+import shutil
 import subprocess
 import sys
 import timeit
 import pprint
 import tempfile
+import threading
 from collections import namedtuple
 import copy
 import distutils.spawn
@@ -22,8 +26,16 @@ else:
   import StringIO as io
 
 from GPUVerifyScript.argument_parser import ArgumentParserError, parse_arguments
+from GPUVerifyScript.boogie_analysis import get_arrays, get_written_arrays, \
+  get_array_accesses, get_loop_heads, \
+  get_candidates, get_proven_locations, get_barrier_calls, get_cas_loops, \
+  get_constants, get_existentials, get_global_variables
 from GPUVerifyScript.constants import AnalysisMode, SourceLanguage
-from GPUVerifyScript.error_codes import ErrorCodes
+from GPUVerifyScript.error_codes import ErrorCodes, error_code_name
+from GPUVerifyScript.error_report import parse_error_report
+from GPUVerifyScript.replay import ReplayError, parse_program, replay_race
+from GPUVerifyScript.uniformity import classify_branches, \
+  parse_uniformity_analysis
 from GPUVerifyScript.json_loader import JSONError, json_load
 import getversion
 
@@ -151,6 +163,11 @@ class GPUVerifyInstance (object):
     cbplFilename = filename + '.cbpl'
     bplFilename = filename + '.bpl'
     locFilename = filename + '.loc'
+    intraGroupBase = filename + '.intra'
+    self.arrayJobBase = filename + '.array'
+    self.boundsJobBase = filename + '.bounds'
+    self.boundsJob = args.bounds_check_job and not args.only_divergence and \
+      args.stop == 'boogie'
 
     if not args.keep_temps:
       def DeleteFile(filename):
@@ -172,6 +189,12 @@ class GPUVerifyInstance (object):
         cleanUpHandler.register(DeleteFile, cbplFilename)
       if not args.stop == 'vcgen':
         cleanUpHandler.register(DeleteFile, bplFilename)
+      if args.intra_group_first:
+        cleanUpHandler.register(DeleteFile, intraGroupBase + '.bpl')
+        cleanUpHandler.register(DeleteFile, intraGroupBase + '.cbpl')
+      if self.boundsJob:
+        cleanUpHandler.register(DeleteFile, self.boundsJobBase + '.bpl')
+        cleanUpHandler.register(DeleteFile, self.boundsJobBase + '.cbpl')
 
     self.defines = self.getDefines(args)
     self.includes = self.getIncludes(args)
@@ -181,6 +204,8 @@ class GPUVerifyInstance (object):
 
     self.optOptions = self.getOptOptions(args)
     self.optOptions += ["-o", optFilename, bcFilename]
+    self.bcFilename = bcFilename
+    self.optFilename = optFilename
 
     self.bugleOptions = self.getBugleOptions(args)
     self.bugleOptions += ["-s", locFilename, "-o", gbplFilename, optFilename]
@@ -188,16 +213,23 @@ class GPUVerifyInstance (object):
     # The .bpl suffix needs to be ignored for /print:
     self.vcgenOptions = self.getVCGenOptions(args)
     self.vcgenOptions += ["/print:" + filename, gbplFilename]
+    self.gbplFilename = gbplFilename
 
     self.cruncherOptions = self.getCruncherOptions(args)
     self.cruncherOptions += [bplFilename]
 
+    self.bplFilename = bplFilename
+    self.cbplFilename = cbplFilename
+
     self.boogieOptions = self.getBoogieOptions(args)
+    self.portfolio = self.getPortfolio(args)
     if args.inference and args.mode != AnalysisMode.FINDBUGS:
       self.boogieOptions += [ cbplFilename ]
     else:
       self.boogieOptions += [ bplFilename ]
       self.skip["cruncher"] = True
+    self.casLoopCandidates = not self.skip["cruncher"] and \
+      "casLoop" not in args.omit_infer
 
     self.timing = {}
     self.outFile = outFile
@@ -206,10 +238,48 @@ class GPUVerifyInstance (object):
     self.mode = args.mode
     self.silent = args.silent
     self.sourceFiles = [args.kernel.name]
+    self.boogieFiles = [f.name for f in args.boogie_file]
     self.SL = args.source_language
     self.loopUnwindDepth = args.loop_unwind
+    self.maxLoopUnwindDepth = args.incremental_loop_unwind
     self.onlyDivergence = args.only_divergence
     self.onlyIntraGroup = args.only_intra_group
+    self.intraGroupBase = intraGroupBase if args.intra_group_first else None
+    self.intraGroupRefuted = set()
+    self.intraGroupTiming = {}
+    self.houdiniCache = args.houdini_cache
+    self.simplifyMemcpy = args.simplify_memcpy
+    # The race instrumentation of a .gbpl file given as input is fixed
+    self.autoRaceInstrumenter = args.race_instrumenter == "auto" and \
+      not self.skip["bugle"]
+    self.jsonErrors = args.json_errors
+    self.errors = []
+    self.replay = args.replay
+    self.groupSize = args.group_size
+    self.numGroups = args.num_groups
+    self.globalOffset = args.global_offset
+    self.output = None
+    self.splitAtBarriers = args.parallel_splits > 1
+    self.arrayJobs = None
+    if not args.only_divergence and not args.only_log:
+      self.arrayJobs = args.parallel_arrays
+    self.keepTemps = args.keep_temps
+    self.kInductionDepths = None
+    if args.adaptive_k_induction and args.mode != AnalysisMode.FINDBUGS:
+      self.kInductionDepths = [args.k_induction_depth] + \
+        list(range(max(1, args.k_induction_depth + 1),
+                   args.adaptive_k_induction + 1))
+    self.parallelKInduction = args.parallel_k_induction
+    self.cruncherIsOptional = not args.boogie_file and \
+      not args.cruncher_options and not args.infer_info and \
+      args.stop != 'cruncher'
+    self.elideReadOnlyArrays = args.elide_read_only_arrays and \
+      not args.only_log and \
+      not any(o.startswith("/checkArrays") for o in self.vcgenOptions)
+
+    self.symmetryReduction = args.symmetry_reduction
+    self.showUniformity = args.show_uniformity
+    self.asymmetry = self.getAsymmetry(args)
 
     self.verbose = args.verbose
     self.time = args.time or (args.time_as_csv is not None)
@@ -217,6 +287,23 @@ class GPUVerifyInstance (object):
     self.debug = args.debug
     self.timeout = args.timeout
 
+  def getAsymmetry(self, args):
+    """ Returns why the checks made on the two threads of the verified program
+        can differ, or None if swapping the threads yields the same checks.
+        Race checking is one-sided: the first thread logs its accesses and
+        the second checks its accesses against the log, so a race is only
+        found for the pair where the logged access comes first. Assertions
+        and barrier divergence are checked for both threads """
+    if not args.only_divergence:
+      return "races are only checked where the first thread logs the access"
+    if args.asymmetric_asserts or "/asymmetricAsserts" in self.vcgenOptions:
+      return "assertions are only checked for the first thread"
+    if args.only_log:
+      return "accesses are only logged for the first thread"
+    if args.boogie_file:
+      return "supporting .bpl files may refer to either thread"
+    return None
+
   def getDefines(self, args):
     defines = ['__BUGLE_' + str(args.size_t) + '__']
 
@@ -268,6 +355,12 @@ class GPUVerifyInstance (object):
     if args.only_requires:
       defines.append("ONLY_REQUIRES")
 
+    if args.native_vectors:
+      defines.append("__BUGLE_NATIVE_VECTORS")
+
+    if args.atomic_counters:
+      defines.append("__BUGLE_ATOMIC_COUNTERS")
+
     defines += args.defines
     return defines
 
@@ -337,6 +430,11 @@ class GPUVerifyInstance (object):
 
   def getOptOptions(self, args):
     options = ["-mem2reg", "-globaldce"]
+    if args.simplify_memcpy:
+      # Forward chains of memcpys through temporaries and merge adjacent
+      # stores, then remove the copies into temporaries no longer read, so
+      # that bugle translates fewer and larger copies
+      options += ["-memcpyopt", "-dse"]
     options += sum([a.split() for a in args.opt_options], [])
     return options
 
@@ -353,7 +451,7 @@ class GPUVerifyInstance (object):
 
     if args.race_instrumenter == "original":
       options.append("-race-instrumentation=original")
-    elif args.race_instrumenter == "watchdog-single":
+    elif args.race_instrumenter in ["watchdog-single", "auto"]:
       options.append("-race-instrumentation=watchdog-single")
     elif args.race_instrumenter == "watchdog-multiple":
       options.append("-race-instrumentation=watchdog-multiple")
@@ -380,7 +478,8 @@ class GPUVerifyInstance (object):
       options.append("/adversarialAbstraction")
     if args.equality_abstraction:
       options.append("/equalityAbstraction")
-    if args.check_array_bounds:
+    # A separate job checks the bounds, see runBoundsJob
+    if args.check_array_bounds and not self.boundsJob:
       options.append("/checkArrayBounds")
     if args.no_benign_tolerance:
       options.append("/noBenign")
@@ -403,16 +502,627 @@ class GPUVerifyInstance (object):
 
     if args.race_instrumenter == "original":
       options.append("/raceChecking:ORIGINAL")
-    elif args.race_instrumenter == "watchdog-single":
+    elif args.race_instrumenter in ["watchdog-single", "auto"]:
       options.append("/raceChecking:SINGLE")
     elif args.race_instrumenter == "watchdog-multiple":
       options.append("/raceChecking:MULTIPLE")
 
+    if args.show_uniformity:
+      options.append("/showUniformityAnalysis")
+
     options += ["/kernelArgs:" + ','.join(map(str,a)) for a in args.kernel_args]
     options += ["/noCandidate:" + a for a in args.omit_infer]
     options += sum([a.split() for a in args.vcgen_options], [])
     return options
 
+  def getReadOnlyElisionOptions(self):
+    """ Returns the VCGen options restricting race checking to the arrays
+        that may be written by the kernel """
+    lines = open(self.gbplFilename, "r").readlines()
+    arrays = [a for a in get_arrays(lines) if a.memory_space != "constant"]
+    written = get_written_arrays(lines)
+    readOnly = [a for a in arrays if a.name not in written]
+
+    if self.verbose:
+      if readOnly:
+        print("Read-only arrays elided from race checking: " +
+          ", ".join(a.source_name for a in readOnly), file = self.outFile)
+      else:
+        print("No read-only arrays to elide from race checking",
+          file = self.outFile)
+
+    if not readOnly:
+      return []
+    elif len(readOnly) == len(arrays):
+      # No array is ever written, so the kernel cannot have a race
+      return ["/onlyDivergence"]
+    else:
+      return ["/checkArrays:" + ",".join(a.source_name for a in arrays \
+                                         if a.name in written)]
+
+  def chooseRaceInstrumenter(self):
+    """ Returns the race instrumenter to use for the .gbpl file: original when
+        the kernel has no loops and few accesses per barrier interval, as
+        there is then little to gain from watching a single offset;
+        watchdog-multiple when many accesses to several arrays share a barrier
+        interval; and watchdog-single otherwise """
+    lines = open(self.gbplFilename, "r").readlines()
+    arrays = get_arrays(lines)
+    accesses = get_array_accesses(lines, [a.name for a in arrays])
+    intervals = len(get_barrier_calls(lines)) + 1
+    perInterval = sum(accesses.values()) / float(intervals)
+    loops = len(get_loop_heads(lines))
+    accessed = len([a for a in accesses if accesses[a] > 0])
+
+    if loops == 0 and perInterval <= 4:
+      choice = "original"
+    elif accessed > 1 and perInterval > 8:
+      choice = "watchdog-multiple"
+    else:
+      choice = "watchdog-single"
+
+    if self.verbose:
+      print("Chose race instrumenter {} for {} array(s) with {:.1f} " \
+        "access(es) per barrier interval and {} loop(s)".format(choice,
+        accessed, perInterval, loops), file = self.outFile)
+    return choice
+
+  def useRaceInstrumenter(self, instrumenter):
+    """ Replace the race instrumenter, watchdog-single, that the options of
+        the components were built with by instrumenter """
+    vcgenOption = "/raceChecking:" + \
+      {"original": "ORIGINAL", "watchdog-multiple": "MULTIPLE"}[instrumenter]
+
+    def replace(options, old, new):
+      return [new if o == old else o for o in options]
+
+    self.bugleOptions = replace(self.bugleOptions,
+      "-race-instrumentation=watchdog-single",
+      "-race-instrumentation=" + instrumenter)
+    self.vcgenOptions = replace(self.vcgenOptions, "/raceChecking:SINGLE",
+      vcgenOption)
+    self.cruncherOptions = replace(self.cruncherOptions,
+      "/raceChecking:SINGLE", vcgenOption)
+    self.boogieOptions = replace(self.boogieOptions, "/raceChecking:SINGLE",
+      vcgenOption)
+
+  def getArrayJobArrays(self):
+    """ Returns the source names of the arrays to be checked by separate jobs
+        for --parallel-arrays """
+    lines = open(self.gbplFilename, "r").readlines()
+    arrays = [a for a in get_arrays(lines) if a.memory_space != "constant"]
+    if self.elideReadOnlyArrays:
+      written = get_written_arrays(lines)
+      arrays = [a for a in arrays if a.name in written]
+    return [a.source_name for a in arrays]
+
+  def runJobCommand(self, tool, command, output, times):
+    """ Run command, the invocation of tool, as part of a job, writing its
+        output to output and recording its time in times. Returns the error
+        code for the exit code of the command """
+    start = timeit.default_timer()
+    proc = psutil.Popen(command, stdout = output, stderr = subprocess.STDOUT,
+                        stdin = subprocess.PIPE)
+    try:
+      exitCode = proc.wait(timeout = self.timeout or None)
+    except psutil.TimeoutExpired:
+      self.terminate(proc)
+      exitCode = None
+    times[tool] = timeit.default_timer() - start
+
+    if exitCode is None:
+      return ErrorCodes.TIMEOUT
+    elif exitCode != 0 and tool == "gpuverifyvcgen":
+      return ErrorCodes.GPUVERIFYVCGEN_ERROR
+    elif exitCode != 0:
+      return self.interpretBoogieDriverCrucherExitCode(exitCode)
+    return ErrorCodes.SUCCESS
+
+  def getJobOptions(self, options, base):
+    """ Return options, the Cruncher or BoogieDriver options of the main
+        check, for a job with files named base. A job runs one solver, the
+        first of a portfolio, and logs its queries to a file of its own """
+    if self.portfolio:
+      options = options + self.portfolio[0][1]
+    return [("/proverLog:" + base + ".smt2") if o.startswith("/proverLog:") \
+            else o for o in options]
+
+  def startBoundsJob(self, refuted):
+    """ Start checking array bounds in a separate job, alongside the race
+        check, which does not check bounds. The job only checks bounds and
+        barrier divergence, so its program has no race instrumentation.
+        The candidates whose keys are in refuted, which the race check
+        refuted, are dropped before invariant inference. Candidates are
+        matched by key rather than by location, as the two VCGen runs need
+        not generate the same candidates at a location; a key only matches
+        a candidate of the same implementation and declarations. Returns
+        the thread running the job """
+    thread = threading.Thread(target = self.runBoundsJob, args = (refuted,))
+    thread.start()
+    return thread
+
+  def runBoundsJob(self, refuted):
+    """ The body of the job started by startBoundsJob. The result is stored
+        in self.boundsResult as a triple (errorCode, times, output) """
+    bplFilename = self.boundsJobBase + ".bpl"
+    cbplFilename = self.boundsJobBase + ".cbpl"
+    output = tempfile.TemporaryFile(mode = 'w+')
+    times = {}
+
+    errorCode = self.runJobCommand("gpuverifyvcgen", self.mono +
+      [gvfindtools.gpuVerifyBinDir + "/GPUVerifyVCGen.exe",
+       "/checkArrayBounds", "/onlyDivergence"] +
+      [("/print:" + self.boundsJobBase) if o.startswith("/print:") else o
+       for o in self.vcgenOptions], output, times)
+
+    prove = bplFilename
+    if errorCode == ErrorCodes.SUCCESS and not self.skip["cruncher"]:
+      with open(bplFilename) as f:
+        lines = f.readlines()
+      candidates = get_candidates(lines)
+      dropped = [c for c in candidates if c.key in refuted]
+      for candidate in dropped:
+        lines[candidate.line] = "\n"
+      if dropped:
+        with open(bplFilename, "w") as f:
+          f.writelines(lines)
+
+      if len(dropped) < len(candidates) or not self.cruncherIsOptional:
+        errorCode = self.runJobCommand("gpuverifycruncher", self.mono +
+          [gvfindtools.gpuVerifyBinDir + os.sep + "GPUVerifyCruncher.exe"] +
+          self.getJobOptions(self.cruncherOptions[:-1], self.boundsJobBase) +
+          [bplFilename], output, times)
+        prove = cbplFilename
+
+    if errorCode == ErrorCodes.SUCCESS:
+      errorCode = self.runJobCommand("gpuverifyboogiedriver", self.mono +
+        [gvfindtools.gpuVerifyBinDir + "/GPUVerifyBoogieDriver.exe"] +
+        self.getJobOptions(self.boogieOptions[:-1], self.boundsJobBase) +
+        [prove], output, times)
+
+    output.seek(0)
+    self.boundsResult = (errorCode, times, output.read())
+    output.close()
+
+  def finishBoundsJob(self, thread, errorCode):
+    """ Wait for the job run by thread and print its output if it did not
+        verify. Returns the error code combining errorCode, the result of the
+        race check, and the result of the job """
+    thread.join()
+    boundsErrorCode, times, output = self.boundsResult
+    for tool, seconds in times.items():
+      self.timing[tool] = self.timing.get(tool, 0.0) + seconds
+    if boundsErrorCode != ErrorCodes.SUCCESS:
+      print(output, end = "", file = self.outFile)
+    if boundsErrorCode == ErrorCodes.NOT_ALL_VERIFIED and self.jsonErrors:
+      self.errors += parse_error_report(output)
+
+    if self.verbose:
+      print("Array bounds check: {} ({:.3f} secs)".format("verified" \
+        if boundsErrorCode == ErrorCodes.SUCCESS else \
+        error_code_name(boundsErrorCode),
+        sum(times.values())), file = self.outFile)
+
+    # A defect found by either check is definite, whatever the other gave
+    for code in [errorCode, boundsErrorCode]:
+      if code != ErrorCodes.SUCCESS and code != ErrorCodes.TIMEOUT:
+        return code
+    if ErrorCodes.TIMEOUT in [errorCode, boundsErrorCode]:
+      return ErrorCodes.TIMEOUT
+    return ErrorCodes.SUCCESS
+
+  def getRefutedKeys(self):
+    """ Return the keys of the candidates of the .bpl file that the
+        Cruncher refuted, or an empty set if the .cbpl file is not
+        understood """
+    with open(self.bplFilename) as f:
+      candidates = get_candidates(f.readlines())
+    with open(self.cbplFilename) as f:
+      proven = get_proven_locations(f.readlines())
+    if not any(c.location in proven for c in candidates):
+      return set()
+    return set(c.key for c in candidates if c.location not in proven)
+
+  def runArrayJobs(self, arrays):
+    """ Check for races on each of arrays in a separate job, with up to
+        self.arrayJobs jobs running at once. A job runs VCGen, restricted to
+        its array, adds the compare-and-swap loop candidates, and runs the
+        Cruncher and the BoogieDriver in turn. The output of
+        the jobs that do not verify and the result of each job are printed.
+        Returns the combined error code """
+    semaphore = threading.Semaphore(self.arrayJobs)
+    results = {}
+
+    def job(index, array):
+      base = self.arrayJobBase + str(index)
+      bplFilename = base + ".bpl"
+      cbplFilename = base + ".cbpl"
+      output = tempfile.TemporaryFile(mode = 'w+')
+      times = {}
+      with semaphore:
+        errorCode = self.runJobCommand("gpuverifyvcgen", self.mono +
+          [gvfindtools.gpuVerifyBinDir + "/GPUVerifyVCGen.exe",
+           "/checkArrays:" + array] +
+          [("/print:" + base) if o.startswith("/print:") else o
+           for o in self.vcgenOptions], output, times)
+
+        if errorCode == ErrorCodes.SUCCESS and self.casLoopCandidates:
+          self.addCASLoopCandidates(bplFilename)
+
+        if errorCode == ErrorCodes.SUCCESS and not self.skip["cruncher"]:
+          errorCode = self.runJobCommand("gpuverifycruncher", self.mono +
+            [gvfindtools.gpuVerifyBinDir + os.sep + "GPUVerifyCruncher.exe"] +
+            self.getJobOptions(self.cruncherOptions[:-1], base) +
+            [bplFilename], output, times)
+
+        if errorCode == ErrorCodes.SUCCESS:
+          errorCode = self.runJobCommand("gpuverifyboogiedriver", self.mono +
+            [gvfindtools.gpuVerifyBinDir + "/GPUVerifyBoogieDriver.exe"] +
+            self.getJobOptions(self.boogieOptions[:-1], base) +
+            [bplFilename if self.skip["cruncher"] else cbplFilename],
+            output, times)
+
+      output.seek(0)
+      results[array] = (errorCode, times, output.read())
+      output.close()
+      if not self.keepTemps:
+        for filename in [bplFilename, cbplFilename]:
+          try:
+            os.remove(filename)
+          except OSError:
+            pass
+
+    threads = [threading.Thread(target = job, args = (i, a)) \
+               for i, a in enumerate(arrays)]
+    for thread in threads:
+      thread.start()
+    for thread in threads:
+      thread.join()
+
+    for array in arrays:
+      errorCode, times, output = results[array]
+      for tool, seconds in times.items():
+        self.timing[tool] = self.timing.get(tool, 0.0) + seconds
+      if errorCode != ErrorCodes.SUCCESS:
+        print(output, end = "", file = self.outFile)
+
+    pad = max(len(a) for a in arrays)
+    print("Results per array:", file = self.outFile)
+    for array in arrays:
+      errorCode, times, _ = results[array]
+      print("- {} : {} ({:.3f} secs)".format(array.ljust(pad),
+        "verified" if errorCode == ErrorCodes.SUCCESS else \
+        error_code_name(errorCode),
+        sum(times.values())), file = self.outFile)
+
+    # A defect found for one array is definite, whatever the other jobs gave
+    errorCodes = [results[a][0] for a in arrays]
+    for errorCode in [ErrorCodes.NOT_ALL_VERIFIED] + errorCodes:
+      if errorCode in errorCodes and errorCode != ErrorCodes.TIMEOUT and \
+         errorCode != ErrorCodes.SUCCESS:
+        return errorCode
+    if ErrorCodes.TIMEOUT in errorCodes:
+      return ErrorCodes.TIMEOUT
+    return ErrorCodes.SUCCESS
+
+  def insertBarrierSplits(self, filename):
+    """ Make Boogie check each barrier interval of the program in filename
+        as a separate piece, by splitting after every barrier """
+    with open(filename) as f:
+      lines = f.readlines()
+
+    calls = get_barrier_calls(lines)
+    for index in reversed(calls):
+      lines.insert(index + 1, "  assert {:split_here} true;\n")
+
+    if self.verbose:
+      print("Splitting at {} barrier(s)".format(len(calls)), file = self.outFile)
+
+    if calls:
+      with open(filename, "w") as f:
+        f.writelines(lines)
+
+  def addCASLoopCandidates(self, bplFilename):
+    """ Add candidate invariants to the loops of bplFilename that retry a
+        compare-and-swap, stating that the accesses logged in the loop are at
+        the offsets the loop accesses. The retry loops of lock-free code need
+        these invariants, which otherwise have to be given by hand """
+    with open(bplFilename) as f:
+      lines = f.readlines()
+
+    variables = get_global_variables(lines)
+    existentials = get_existentials(lines)
+    number = 0
+    added = []
+    for loop in sorted(get_cas_loops(lines), key = lambda l: -l.head):
+      for kind, array, offset in reversed(loop.accesses):
+        occurred = "_" + kind + "_HAS_OCCURRED_$$" + array
+        for variable in ["_" + kind + "_OFFSET_$$" + array,
+                         "_WATCHED_OFFSET_$$" + array, "_WATCHED_OFFSET"]:
+          if variable in variables:
+            break
+        else:
+          continue
+        if occurred not in variables:
+          continue
+        while "_b" + str(number) in existentials:
+          number += 1
+        existentials.add("_b" + str(number))
+        added.append("_b" + str(number))
+        lines.insert(loop.head + 1, "  assert {:tag \"casLoop\"} {:thread 1} " +
+          "_b" + str(number) + " ==> " + occurred + " ==> " + variable +
+          " == " + offset + ";\n")
+
+    if self.verbose:
+      print("Adding {} candidate(s) to compare-and-swap loops".format(
+        len(added)), file = self.outFile)
+
+    if added:
+      lines[0:0] = ["const {:existential true} " + name + ": bool;\n"
+                    for name in added]
+      with open(bplFilename, "w") as f:
+        f.writelines(lines)
+
+  def addSymmetryBreaking(self):
+    """ Order the two threads of the .bpl file by their group and local ids.
+        A pair of distinct threads is considered in one order only, which
+        halves the pairs the prover searches """
+    if self.asymmetry:
+      if self.verbose:
+        print("Not applying symmetry reduction: " + self.asymmetry,
+              file = self.outFile)
+      return
+
+    with open(self.bplFilename) as f:
+      lines = f.readlines()
+
+    constants = get_constants(lines)
+    ids = [(name, constants[name + "$1"]) for name in \
+           ["group_id_z", "group_id_y", "group_id_x",
+            "local_id_z", "local_id_y", "local_id_x"] \
+           if constants.get(name + "$1") == constants.get(name + "$2") and \
+           name + "$1" in constants]
+    if not ids:
+      if self.verbose:
+        print("Not applying symmetry reduction: no thread ids found",
+              file = self.outFile)
+      return
+
+    order = "false"
+    for name, type in reversed(ids):
+      if type == "int":
+        precedes = "{0}$1 < {0}$2".format(name)
+      else:
+        precedes = "_SYMMETRY_ULT_{0}({1}$1, {1}$2)".format(type, name)
+      order = "({0} || ({1}$1 == {1}$2 && {2}))".format(precedes, name, order)
+
+    lines.append("\n")
+    for type in sorted(set(t for _, t in ids if t != "int")):
+      lines.append("function {{:bvbuiltin \"bvult\"}} _SYMMETRY_ULT_{0}" \
+        "({0}, {0}) : bool;\n".format(type))
+    lines.append("axiom " + order + ";\n")
+
+    if self.verbose:
+      print("Ordering the two threads by " + ", ".join(n for n, _ in ids),
+            file = self.outFile)
+
+    with open(self.bplFilename, "w") as f:
+      f.writelines(lines)
+
+  def reportUniformity(self):
+    """ Summarise the results of the uniformity analysis printed by
+        GPUVerifyVCGen, with the branches of the .gbpl file they make
+        uniform """
+    procedures = parse_uniformity_analysis(self.output or "")
+    if not procedures:
+      print("No uniformity analysis results were found", file = self.outFile)
+      return
+
+    with open(self.gbplFilename) as f:
+      classify_branches(f.readlines(), procedures)
+
+    variables = branches = uniformVariables = uniformBranches = 0
+    print("Uniformity analysis:", file = self.outFile)
+    for procedure in procedures:
+      uniform = procedure.uniform_variables()
+      nonUniform = procedure.non_uniform_variables()
+      uniformGuards = sorted(g for g, u in procedure.branches.items() if u)
+      print("- {}{}".format(procedure.procedure, "" if procedure.uniform is None
+        else " (uniform control flow)" if procedure.uniform
+        else " (non-uniform control flow)"), file = self.outFile)
+      print("    uniform variables ({}): {}".format(len(uniform),
+        ", ".join(uniform)), file = self.outFile)
+      print("    non-uniform variables ({}): {}".format(len(nonUniform),
+        ", ".join(nonUniform)), file = self.outFile)
+      print("    uniform branches ({} of {}): {}".format(len(uniformGuards),
+        len(procedure.branches), ", ".join(uniformGuards)), file = self.outFile)
+      variables += len(procedure.variables)
+      uniformVariables += len(uniform)
+      branches += len(procedure.branches)
+      uniformBranches += len(uniformGuards)
+
+    print("{} of {} variable(s) need no copy for the second thread, and {} " \
+      "of {} branch(es) need no predication".format(uniformVariables,
+      variables, uniformBranches, branches), file = self.outFile)
+
+  def hasCandidates(self):
+    """ Returns whether the .bpl file contains candidate invariants """
+    with open(self.bplFilename) as f:
+      return len(get_candidates(f.readlines())) > 0
+
+  def runIntraGroupPhase(self):
+    """ Check the kernel for intra-group races and barrier divergence only.
+        Returns the error code to stop with, or None if the check passed.
+        The locations of the
+        candidates refuted by the Cruncher are recorded, as these are also
+        refuted when inter-group races are checked: the intra-group program
+        only restricts the threads considered to be in the same group """
+    intraGroup = "/onlyIntraGroupRaceChecking"
+    bplFilename = self.intraGroupBase + ".bpl"
+    cbplFilename = self.intraGroupBase + ".cbpl"
+
+    if self.verbose:
+      print("Checking intra-group races first", file = self.outFile)
+
+    success, timeout = self.runTool("gpuverifyvcgen", self.mono +
+      [gvfindtools.gpuVerifyBinDir + "/GPUVerifyVCGen.exe", intraGroup] +
+      [("/print:" + self.intraGroupBase) if o.startswith("/print:") else o
+       for o in self.vcgenOptions])
+    if timeout: return ErrorCodes.TIMEOUT
+    if success != 0: return ErrorCodes.GPUVERIFYVCGEN_ERROR
+
+    with open(bplFilename) as f:
+      candidates = get_candidates(f.readlines())
+
+    prove = bplFilename
+    if not self.skip["cruncher"] and candidates:
+      command = self.mono + \
+        [gvfindtools.gpuVerifyBinDir + os.sep + "GPUVerifyCruncher.exe"] + \
+        self.cruncherOptions[:-1] + [intraGroup, bplFilename]
+      if self.portfolio:
+        success, timeout = self.runCruncherPortfolio(command, bplFilename)
+      else:
+        success, timeout = self.runTool("gpuverifycruncher", command)
+      if timeout: return ErrorCodes.TIMEOUT
+      if success != 0:
+        return self.interpretBoogieDriverCrucherExitCode(success)
+
+      with open(cbplFilename) as f:
+        proven = get_proven_locations(f.readlines())
+      # As for the Houdini cache, only trust a .cbpl file that we understand
+      if any(c.location in proven for c in candidates):
+        self.intraGroupRefuted = set(c.location for c in candidates \
+                                     if c.location not in proven)
+      prove = cbplFilename
+
+    success, timeout = self.runProver("gpuverifyboogiedriver", self.mono +
+      [gvfindtools.gpuVerifyBinDir + "/GPUVerifyBoogieDriver.exe"] +
+      self.boogieOptions[:-1] + [intraGroup, prove])
+
+    if (timeout or success != 0) and self.verbose:
+      print("Not checking inter-group races, as the intra-group check " \
+        "did not pass", file = self.outFile)
+
+    if timeout: return ErrorCodes.TIMEOUT
+    if success != 0:
+      self.reportErrors(success)
+      return self.interpretBoogieDriverCrucherExitCode(success)
+
+    # Time both phases together
+    for tool in ["gpuverifyvcgen", "gpuverifycruncher", "gpuverifyboogiedriver"]:
+      if tool in self.timing:
+        self.intraGroupTiming[tool] = self.timing.pop(tool)
+    return None
+
+  def applyIntraGroupRefutations(self):
+    """ Remove the candidates refuted by the intra-group phase from the .bpl
+        file """
+    with open(self.bplFilename) as f:
+      lines = f.readlines()
+
+    refuted = [c for c in get_candidates(lines) \
+               if c.location in self.intraGroupRefuted]
+
+    if self.verbose:
+      print("Dropping {} candidate(s) refuted by the intra-group phase".format(
+        len(refuted)), file = self.outFile)
+
+    if refuted:
+      for candidate in refuted:
+        lines[candidate.line] = "\n"
+      with open(self.bplFilename, "w") as f:
+        f.writelines(lines)
+
+  def applyHoudiniCache(self):
+    """ Remove the candidates refuted by previous runs from the .bpl file.
+        Returns the candidates that remain """
+    try:
+      with open(self.houdiniCache) as f:
+        self.houdiniCacheEntries = json.load(f)
+    except (IOError, ValueError):
+      self.houdiniCacheEntries = {}
+    if not isinstance(self.houdiniCacheEntries, dict):
+      self.houdiniCacheEntries = {}
+
+    with open(self.bplFilename) as f:
+      lines = f.readlines()
+
+    candidates = self.getHoudiniCacheCandidates(lines)
+    refuted = [c for c in candidates \
+               if self.houdiniCacheEntries.get(c.key) == False]
+
+    # Never modify a .bpl file given as input
+    if self.bplFilename in self.sourceFiles:
+      refuted = []
+
+    if self.verbose:
+      proven = [c for c in candidates if self.houdiniCacheEntries.get(c.key)]
+      print("Houdini cache: {} of {} candidates were proven and {} refuted " \
+        "by previous runs".format(len(proven), len(candidates), len(refuted)),
+        file = self.outFile)
+
+    if refuted:
+      for candidate in refuted:
+        lines[candidate.line] = "\n"
+      with open(self.bplFilename, "w") as f:
+        f.writelines(lines)
+
+    return [c for c in candidates if c not in refuted]
+
+  def getHoudiniCacheCandidates(self, lines):
+    """ Return the candidates of lines, keyed for the Houdini cache. Whether
+        Houdini proves a candidate also depends on how the Cruncher is run,
+        e.g., on the solver, the k-induction depth and the supporting .bpl
+        files, so the Cruncher options and the contents of the files given
+        to the Cruncher are part of the key """
+    configuration = hashlib.sha1()
+    for option in self.cruncherOptions[:-1]:
+      configuration.update((option + "\n").encode("utf-8"))
+      if option in self.boogieFiles:
+        with open(option, "rb") as f:
+          configuration.update(f.read())
+
+    candidates = get_candidates(lines)
+    for candidate in candidates:
+      digest = configuration.copy()
+      digest.update(candidate.key.encode("utf-8"))
+      candidate.key = digest.hexdigest()
+    return candidates
+
+  def updateHoudiniCache(self, candidates):
+    """ Record which of candidates were proven by the Cruncher """
+    with open(self.cbplFilename) as f:
+      proven = get_proven_locations(f.readlines())
+
+    # If no candidate is recognised as proven, the .cbpl file cannot be told
+    # apart from one in a format we do not understand; record nothing
+    if not any(c.location in proven for c in candidates):
+      return
+
+    for candidate in candidates:
+      self.houdiniCacheEntries[candidate.key] = candidate.location in proven
+
+    with open(self.houdiniCache, "w") as f:
+      json.dump(self.houdiniCacheEntries, f, indent = 2, sort_keys = True)
+      f.write("\n")
+
+  def countMemcpyCalls(self, bitcodeFilename):
+    """ Return the number of memcpy calls in an LLVM bitcode file, or None if
+        the file cannot be disassembled """
+    try:
+      ir = subprocess.check_output([gvfindtools.llvmBinDir + "/opt", "-S",
+        "-o", "-", bitcodeFilename], stderr = subprocess.STDOUT)
+    except (OSError, subprocess.CalledProcessError):
+      return None
+    return ir.decode("utf-8", "replace").count("call void @llvm.memcpy.")
+
+  def reportMemcpySimplification(self):
+    before = self.countMemcpyCalls(self.bcFilename)
+    after = self.countMemcpyCalls(self.optFilename)
+    if before is not None and after is not None:
+      print("memcpy simplification: {} of {} memcpy call(s) remain".format(
+        after, before), file = self.outFile)
+
   def getSharedCruncherAndBoogieOptions(self, args):
     options = ["/nologo", "/typeEncoding:m", "/mv:-", "/doModSetAnalysis",
       "/useArrayTheory", "/doNotUseLabels", "/enhancedErrorMessages:1"]
@@ -430,25 +1140,20 @@ class GPUVerifyInstance (object):
 
     if not args.math_int:
       options.append("/proverOpt:OPTIMIZE_FOR_BV=true")
-      if args.solver == "z3":
-        options += ["/z3opt:smt.relevancy=0"]
 
-    if args.solver == "z3":
-      options.append("/z3exe:" + gvfindtools.z3BinDir + os.sep + "z3.exe")
-    elif args.solver == "cvc4":
-      options.append("/proverOpt:SOLVER=cvc4")
-      options.append("/cvc4exe:" + gvfindtools.cvc4BinDir + os.sep + "cvc4.exe")
-      options.append("/proverOpt:LOGIC=QF_ALL_SUPPORTED")
+    # With a portfolio the solver options differ per run; see getPortfolio
+    if args.solver != "portfolio":
+      options += self.getSolverOptions(args, args.solver)
 
-    if args.gen_smt2:
-      options.append("/proverLog:" + args.kernel_name + ".smt2")
+      if args.gen_smt2:
+        options.append("/proverLog:" + args.kernel_name + ".smt2")
 
     if args.only_intra_group:
       options.append("/onlyIntraGroupRaceChecking")
 
     if args.race_instrumenter == "original":
       options.append("/raceChecking:ORIGINAL")
-    elif args.race_instrumenter == "watchdog-single":
+    elif args.race_instrumenter in ["watchdog-single", "auto"]:
       options.append("/raceChecking:SINGLE")
     elif args.race_instrumenter == "watchdog-multiple":
       options.append("/raceChecking:MULTIPLE")
@@ -461,10 +1166,60 @@ class GPUVerifyInstance (object):
 
     return options
 
+  def getSolverOptions(self, args, solver):
+    options = []
+
+    if solver == "z3":
+      if not args.math_int:
+        options.append("/z3opt:smt.relevancy=0")
+      options.append("/z3exe:" + gvfindtools.z3BinDir + os.sep + "z3.exe")
+    elif solver == "cvc4":
+      options.append("/proverOpt:SOLVER=cvc4")
+      options.append("/cvc4exe:" + gvfindtools.cvc4BinDir + os.sep + "cvc4.exe")
+      options.append("/proverOpt:LOGIC=QF_ALL_SUPPORTED")
+
+    return options
+
+  def getPortfolio(self, args):
+    """ Returns a list of (name, options) pairs, one for each configuration
+        to be run by --solver=portfolio, or None if no portfolio is used """
+    if args.solver != "portfolio":
+      return None
+
+    portfolio = [("z3", self.getSolverOptions(args, "z3")),
+                 ("cvc4", self.getSolverOptions(args, "cvc4"))]
+
+    for seed in range(1, args.portfolio_seeds + 1):
+      portfolio.append(("z3-seed" + str(seed),
+        self.getSolverOptions(args, "z3") +
+        ["/z3opt:smt.random_seed=" + str(seed)]))
+
+    if args.gen_smt2:
+      for name, options in portfolio:
+        options.append("/proverLog:" + args.kernel_name + "." + name + ".smt2")
+
+    return portfolio
+
+  def getParallelInferencePipeline(self, args):
+    """ Returns a Cruncher pipeline of Houdini engines that run in parallel
+        and share refuted candidates. The engines differ in how many
+        candidates they refute per query, so they explore the candidates in
+        different orders """
+    engines = []
+    for i in range(args.parallel_inference):
+      parameters = ["errorlimit=" + str(2 ** i)]
+      if args.solver != "portfolio":
+        parameters.insert(0, "solver=" + args.solver)
+      engines.append("HOUDINI[" + ",".join(parameters) + "]")
+    return "[" + "-".join(engines) + "]"
+
   def getCruncherOptions(self, args):
     options = self.getSharedCruncherAndBoogieOptions(args)
     options += ["/noinfer", "/contractInfer", "/concurrentHoudini"]
 
+    if args.parallel_inference > 1:
+      options.append("/parallel:" + self.getParallelInferencePipeline(args))
+
     if args.infer_info:
       options.append("/trace")
 
@@ -478,12 +1233,18 @@ class GPUVerifyInstance (object):
     if args.mode == AnalysisMode.FINDBUGS:
       options.append("/loopUnroll:" + str(args.loop_unwind))
 
+    if args.parallel_splits > 1:
+      options.append("/vcsCores:" + str(args.parallel_splits))
+      if args.verbose:
+        options.append("/trace")
+
     options += sum([a.split() for a in args.boogie_options], [])
     return options
 
-  def run(self, command):
+  def run(self, command, capture = False):
     """ Run a command with an optional timeout. A timeout of zero
-        implies no timeout.
+        implies no timeout. If capture is set, the output of the command is
+        also stored in self.output.
     """
     popenargs={}
     if self.verbose:
@@ -492,41 +1253,281 @@ class GPUVerifyInstance (object):
     else:
       popenargs['bufsize']=0
 
-    popenargs["stdout"] = self.outFile
+    output = tempfile.TemporaryFile(mode = 'w+') if capture else None
+    popenargs["stdout"] = output or self.outFile
     popenargs["stderr"] = self.errFile
 
     # Redirect stdin, othewise terminal text becomes unreadable after timeout
     popenargs['stdin']=subprocess.PIPE
 
-    proc = psutil.Popen(command, **popenargs)
+    try:
+      proc = psutil.Popen(command, **popenargs)
+      if args.timeout > 0:
+        try:
+          return_code = proc.wait(timeout = self.timeout)
+        except psutil.TimeoutExpired:
+          self.terminate(proc)
+          raise
+      else:
+        return_code = proc.wait()
+    finally:
+      if output:
+        output.seek(0)
+        self.output = output.read()
+        output.close()
+        print(self.output, end = "", file = self.outFile)
+
+    return return_code
+
+  def terminate(self, proc):
+    """ Terminate proc and all of its children """
     if "get_children" not in dir(proc):
       proc.get_children = proc.children
-    if args.timeout > 0:
+    try:
+      children = proc.get_children(recursive=True)
+      proc.terminate()
+    except psutil.NoSuchProcess:
+      return
+    for child in children:
       try:
-        return_code = proc.wait(timeout = self.timeout)
-      except psutil.TimeoutExpired:
-        children = proc.get_children(recursive=True)
-        proc.terminate()
-        for child in children:
+        child.terminate()
+      except psutil.NoSuchProcess:
+        pass
+
+  def runPortfolio(self, ToolName, Commands, Names, Definite = [0, 3],
+                   Jobs = None, Timeout = None, Rank = None):
+    """ Run Commands, named by Names, with at most Jobs running at once (by
+        default all). The result of the first command to give a definite
+        answer, i.e., to exit with a code in Definite, is kept and the other
+        commands are terminated. Exit code 3 also covers inconclusive results
+        and timeouts of single queries, so it is only definite when the output
+        holds an error report. If no command gives a definite answer, the
+        result of the command with the highest Rank, a function of the index
+        of a command, is kept, or by default that of the last command to
+        finish. Timeout defaults to the --timeout given. Returns a triple
+        (index, exitCode, timeout), where index identifies the kept command
+    """
+    if Timeout is None:
+      Timeout = self.timeout
+
+    assert ToolName in Tools
+    if self.verbose:
+      print("Running " + ToolName + " portfolio", file=self.outFile)
+      self.outFile.flush()
+
+    outputs = {}
+    procs = {}
+    pending = list(range(len(Commands)))
+    running = []
+    winner = None
+    finished = []
+    start = timeit.default_timer()
+    try:
+      while winner is None and (pending or running):
+        while pending and (Jobs is None or len(running) < Jobs):
+          index = pending.pop(0)
+          if self.verbose:
+            print(" ".join(Commands[index]), file = self.outFile)
+            self.outFile.flush()
+          outputs[index] = tempfile.TemporaryFile(mode = 'w+')
+          procs[index] = psutil.Popen(Commands[index], stdout = outputs[index],
+            stderr = subprocess.STDOUT, stdin = subprocess.PIPE)
+          running.append(procs[index])
+
+        gone, running = psutil.wait_procs(running, timeout = 0.1)
+        for proc in gone:
+          index = [i for i in procs if procs[i] is proc][0]
+          finished.append(index)
+          if winner is None and proc.returncode in Definite and \
+             (proc.returncode != 3 or self.reportsErrors(outputs[index])):
+            winner = index
+        if Timeout > 0 and timeit.default_timer() - start > Timeout:
+          break
+    except (OSError,WindowsError) as e:
+      print("Error while invoking {} : {}".format(ToolName, str(e)))
+      print("With command line args:")
+      print(pprint.pformat(Commands))
+      raise
+    finally:
+      for proc in procs.values():
+        if proc.is_running():
+          self.terminate(proc)
+
+    if winner is None and (pending or running):
+      self.timing[ToolName] = Timeout
+      print("{} timed out. Use --timeout=N with N > {} to increase timeout, or --timeout=0 to disable timeout.\n".format(ToolName, self.timeout), file=self.outFile)
+      return 0, False, True
+
+    self.timing[ToolName] = timeit.default_timer() - start
+    index = winner
+    if index is None:
+      index = max(finished, key = Rank) if Rank else finished[-1]
+    if self.verbose:
+      print("Using the result of " + Names[index], file=self.outFile)
+    outputs[index].seek(0)
+    self.output = outputs[index].read()
+    print(self.output, end = "", file = self.outFile)
+    for output in outputs.values():
+      output.close()
+    return index, procs[index].returncode, False
+
+  def reportsErrors(self, output):
+    """ Whether output, the file a command wrote to, holds an error report """
+    output.seek(0)
+    return len(parse_error_report(output.read())) > 0
+
+  def runProver(self, ToolName, Command):
+    """ As runTool, but using a solver portfolio when requested. The output
+        is captured when it is needed to write or replay the errors """
+    if not self.portfolio and not self.jsonErrors and not self.replay:
+      return self.runTool(ToolName, Command)
+
+    portfolio = self.portfolio or [("", [])]
+    _, exitCode, timeout = self.runPortfolio(ToolName,
+      [Command + options for _, options in portfolio],
+      [name for name, _ in portfolio])
+    return exitCode, timeout
+
+  def reportErrors(self, exitCode):
+    """ Replay and record for writing as JSON, as requested, the errors
+        reported by the BoogieDriver when it exited with exitCode """
+    if exitCode == 3 and (self.jsonErrors or self.replay):
+      errors = parse_error_report(self.output or "")
+      if self.replay:
+        self.replayRaces(errors)
+      self.errors += errors
+
+  def replayRaces(self, errors):
+    """ Replay each race in errors on the .gbpl file, print the verdicts and
+        record them in errors """
+    try:
+      with open(self.gbplFilename) as f:
+        program = parse_program(f.read())
+    except (IOError, ReplayError) as e:
+      print("Cannot replay races: " + str(e), file=self.outFile)
+      return
+
+    for error in errors:
+      if error["kind"] != "race":
+        continue
+      replay = replay_race(program, error, self.groupSize, self.numGroups,
+                           self.globalOffset)
+      error["replay"] = { "verdict": replay.verdict, "reason": replay.reason }
+      print("Replay of race at {file}:{line}:{column}: ".format(
+        **error["location"]) + replay.verdict + " (" + replay.reason + ")",
+        file=self.outFile)
+
+  def writeJSONErrors(self, exitCode):
+    """ Write the errors reported by the BoogieDriver to self.jsonErrors,
+        along with the thread configuration they were found for and the
+        verdict, the name of exitCode. The file is written whatever the
+        outcome, so that no file from an earlier run is left in place """
+    with open(self.jsonErrors, "w") as f:
+      json.dump({ "kernels": self.sourceFiles, "local_size": self.groupSize,
+                  "num_groups": self.numGroups, "errors": self.errors,
+                  "verdict": error_code_name(exitCode) },
+                f, indent = 2, sort_keys = True)
+      f.write("\n")
+
+  def runAdaptiveKInduction(self, Command):
+    """ Run the BoogieDriver with k-induction for each depth in
+        self.kInductionDepths, in turn or in parallel, until the kernel
+        verifies. The result of the deepest attempt is kept otherwise """
+    Command = [o for o in Command if not o.startswith("/kInductionDepth:")]
+    portfolio = self.portfolio or [("", [])]
+
+    commands = []
+    names = []
+    depths = []
+    for k in self.kInductionDepths:
+      for name, options in portfolio:
+        commands.append(Command + options +
+          (["/kInductionDepth:" + str(k)] if k > 0 else []))
+        names.append(" ".join(["k=" + str(k), name]).strip())
+        depths.append(k)
+
+    # In parallel, the deepest attempt need not be the last to finish
+    _, exitCode, timeout = self.runPortfolio("gpuverifyboogiedriver", commands,
+      names, Definite = [0],
+      Jobs = None if self.parallelKInduction else len(portfolio),
+      Rank = lambda index: depths[index])
+    return exitCode, timeout
+
+  def runIncrementalUnwinding(self, Command):
+    """ Run the BoogieDriver with loops unwound once more on each run, from
+        --loop-unwind up to --incremental-loop-unwind times, until a defect is
+        found or --timeout seconds have elapsed in total. Running out of time
+        after some depth has been checked is not an error """
+    Command = [o for o in Command if not o.startswith("/loopUnroll:")]
+    portfolio = self.portfolio or [("", [])]
+    start = timeit.default_timer()
+    checked = False
+
+    for depth in range(self.loopUnwindDepth, self.maxLoopUnwindDepth + 1):
+      remaining = 0
+      if self.timeout > 0:
+        remaining = self.timeout - (timeit.default_timer() - start)
+        if remaining <= 0:
+          break
+
+      _, exitCode, timeout = self.runPortfolio("gpuverifyboogiedriver",
+        [Command + options + ["/loopUnroll:" + str(depth)]
+         for _, options in portfolio],
+        [" ".join(["loop-unwind=" + str(depth), name]).strip()
+         for name, _ in portfolio],
+        Timeout = remaining)
+
+      if timeout or exitCode != 0:
+        break
+      self.loopUnwindDepth = depth
+      checked = True
+
+    self.timing["gpuverifyboogiedriver"] = timeit.default_timer() - start
+
+    if exitCode == 3:
+      print("Defect found with --loop-unwind=" + str(depth), file=self.outFile)
+    if timeout and checked:
+      return 0, False
+    return exitCode, timeout
+
+  def runCruncherPortfolio(self, Command, bplFilename):
+    """ As runProver for the Cruncher on bplFilename. The Cruncher writes its
+        output next to its input, so each configuration crunches its own copy
+        of the .bpl file """
+    base, ext = os.path.splitext(bplFilename)
+    inputs = [base + "." + name + ext for name, _ in self.portfolio]
+    try:
+      for filename in inputs:
+        shutil.copyfile(bplFilename, filename)
+
+      index, exitCode, timeout = self.runPortfolio("gpuverifycruncher",
+        [[filename if o == bplFilename else o for o in Command] + options
+         for filename, (_, options) in zip(inputs, self.portfolio)],
+        [name for name, _ in self.portfolio])
+
+      if not timeout and exitCode == 0:
+        shutil.move(os.path.splitext(inputs[index])[0] + ".cbpl",
+                    base + ".cbpl")
+    finally:
+      for filename in inputs:
+        for f in [filename, os.path.splitext(filename)[0] + ".cbpl"]:
           try:
-            child.terminate()
-          except psutil.NoSuchProcess:
+            os.remove(f)
+          except OSError:
             pass
-        raise
-    else:
-      return_code = proc.wait()
 
-    return return_code
+    return exitCode, timeout
 
-  def runTool(self, ToolName, Command):
-    """ Returns a triple (succeeded, timeout) """
+  def runTool(self, ToolName, Command, Capture = False):
+    """ Returns a pair (succeeded, timeout). With Capture, the output of the
+        tool is also stored in self.output """
     assert ToolName in Tools
     if self.verbose:
       print("Running " + ToolName, file=self.outFile)
       self.outFile.flush()
     try:
       start = timeit.default_timer()
-      exitCode = self.run(Command)
+      exitCode = self.run(Command, Capture)
       end = timeit.default_timer()
     except psutil.TimeoutExpired:
       self.timing[ToolName] = self.timeout
@@ -575,6 +1576,9 @@ class GPUVerifyInstance (object):
       if timeout: return ErrorCodes.TIMEOUT
       if success != 0: return ErrorCodes.OPT_ERROR
 
+      if self.simplifyMemcpy and self.verbose:
+        self.reportMemcpySimplification()
+
     if self.stop == 'opt': return ErrorCodes.SUCCESS
 
     if not self.skip["bugle"]:
@@ -585,40 +1589,135 @@ class GPUVerifyInstance (object):
       if timeout: return ErrorCodes.TIMEOUT
       if success != 0: return ErrorCodes.BUGLE_ERROR
 
+    if self.autoRaceInstrumenter:
+      instrumenter = self.chooseRaceInstrumenter()
+      if instrumenter != "watchdog-single":
+        # Bugle instruments the kernel, so it has to run again
+        self.useRaceInstrumenter(instrumenter)
+        previous = self.timing.get("bugle", 0.0)
+        success, timeout = self.runTool("bugle",
+                [gvfindtools.bugleBinDir + "/bugle"] +
+                self.bugleOptions)
+        self.timing["bugle"] += previous
+
+        if timeout: return ErrorCodes.TIMEOUT
+        if success != 0: return ErrorCodes.BUGLE_ERROR
+
     if self.stop == 'bugle': return ErrorCodes.SUCCESS
 
+    if self.intraGroupBase and self.stop != 'vcgen' and \
+       self.stop != 'cruncher':
+      errorCode = self.runIntraGroupPhase()
+      if errorCode is not None: return errorCode
+
+    if self.arrayJobs and not self.skip["vcgen"] and self.stop == 'boogie':
+      arrays = self.getArrayJobArrays()
+      if len(arrays) > 1:
+        boundsJob = self.startBoundsJob(set()) if self.boundsJob else None
+        errorCode = self.runArrayJobs(arrays)
+        if boundsJob:
+          errorCode = self.finishBoundsJob(boundsJob, errorCode)
+        if errorCode != ErrorCodes.SUCCESS: return errorCode
+        return self.reportSuccess()
+
     if not self.skip["vcgen"]:
-      success, timeout = self.runTool("gpuverifyvcgen",
-              self.mono +
-              [gvfindtools.gpuVerifyBinDir + "/GPUVerifyVCGen.exe"] +
-              self.vcgenOptions)
+      if self.elideReadOnlyArrays:
+        self.vcgenOptions = self.getReadOnlyElisionOptions() + self.vcgenOptions
+
+      command = self.mono + \
+                [gvfindtools.gpuVerifyBinDir + "/GPUVerifyVCGen.exe"] + \
+                self.vcgenOptions
+      # With --show-uniformity the output holds the results of the analysis
+      success, timeout = self.runTool("gpuverifyvcgen", command,
+                                      Capture = self.showUniformity)
 
       if timeout: return ErrorCodes.TIMEOUT
       if success != 0: return ErrorCodes.GPUVERIFYVCGEN_ERROR
 
+      if self.showUniformity:
+        self.reportUniformity()
+
+    if self.casLoopCandidates and not self.skip["vcgen"]:
+      self.addCASLoopCandidates(self.bplFilename)
+
+    if self.symmetryReduction and not self.skip["vcgen"]:
+      self.addSymmetryBreaking()
+
     if self.stop == 'vcgen': return ErrorCodes.SUCCESS
 
+    if self.intraGroupRefuted and not self.skip["cruncher"]:
+      self.applyIntraGroupRefutations()
+
+    if not self.skip["cruncher"] and self.cruncherIsOptional and \
+       not self.hasCandidates():
+      # Without candidates Houdini has nothing to infer, so the BoogieDriver
+      # can check the .bpl file directly instead of the Cruncher first
+      # encoding and checking the same program
+      if self.verbose:
+        print("No candidate invariants to infer; skipping the Cruncher",
+              file = self.outFile)
+      self.skip["cruncher"] = True
+      self.boogieOptions[-1] = self.bplFilename
+
     if not self.skip["cruncher"]:
-      success, timeout = self.runTool("gpuverifycruncher",
-                self.mono +
-                [gvfindtools.gpuVerifyBinDir + os.sep + "GPUVerifyCruncher.exe"] +
-                self.cruncherOptions)
+      if self.houdiniCache:
+        candidates = self.applyHoudiniCache()
+
+      command = self.mono + \
+                [gvfindtools.gpuVerifyBinDir + os.sep + "GPUVerifyCruncher.exe"] + \
+                self.cruncherOptions
+      if self.portfolio:
+        success, timeout = self.runCruncherPortfolio(command,
+                                                     self.bplFilename)
+      else:
+        success, timeout = self.runTool("gpuverifycruncher", command)
 
       if timeout: return ErrorCodes.TIMEOUT
       if success != 0:
         return self.interpretBoogieDriverCrucherExitCode(success)
 
+      if self.houdiniCache:
+        self.updateHoudiniCache(candidates)
+
     if self.stop == 'cruncher': return ErrorCodes.SUCCESS
 
-    success, timeout = self.runTool("gpuverifyboogiedriver",
-            self.mono +
-            [gvfindtools.gpuVerifyBinDir + "/GPUVerifyBoogieDriver.exe"] +
-            self.boogieOptions)
+    boundsJob = None
+    if self.boundsJob:
+      boundsJob = self.startBoundsJob(set() if self.skip["cruncher"] else
+                                      self.getRefutedKeys())
+
+    errorCode = self.runBoogieDriver()
+    if boundsJob:
+      errorCode = self.finishBoundsJob(boundsJob, errorCode)
+    if errorCode != ErrorCodes.SUCCESS: return errorCode
+    return self.reportSuccess()
+
+  def runBoogieDriver(self):
+    """ Run the BoogieDriver on the .bpl or .cbpl file. Returns the error
+        code, after reporting the errors found """
+    # Never modify a file given as input
+    if self.splitAtBarriers and self.boogieOptions[-1] not in self.sourceFiles:
+      self.insertBarrierSplits(self.boogieOptions[-1])
+
+    command = self.mono + \
+              [gvfindtools.gpuVerifyBinDir + "/GPUVerifyBoogieDriver.exe"] + \
+              self.boogieOptions
+    if self.kInductionDepths:
+      success, timeout = self.runAdaptiveKInduction(command)
+    elif self.mode == AnalysisMode.FINDBUGS and self.maxLoopUnwindDepth:
+      success, timeout = self.runIncrementalUnwinding(command)
+    else:
+      success, timeout = self.runProver("gpuverifyboogiedriver", command)
 
     if timeout: return ErrorCodes.TIMEOUT
     if success != 0:
+      self.reportErrors(success)
       return self.interpretBoogieDriverCrucherExitCode(success)
 
+    return ErrorCodes.SUCCESS
+
+  def reportSuccess(self):
+    """ Print that no defects were found, unless silent """
     if self.silent:
       return ErrorCodes.SUCCESS
 
@@ -643,6 +1742,10 @@ class GPUVerifyInstance (object):
 
   def getTiming(self, exitCode):
     """ Returns the timing as a string """
+    for tool, seconds in self.intraGroupTiming.items():
+      self.timing[tool] = self.timing.get(tool, 0.0) + seconds
+    self.intraGroupTiming = {}
+
     if self.timeCSVLabel is not None:
       times = [ self.timing.get(tool, 0.0) for tool in Tools ]
       total = sum(times)
@@ -851,6 +1954,65 @@ def do_json_mode(args):
   if args.cache != None:
     pickle.dump(success_cache, open(args.cache, "w"))
 
+def benchmark_race_instrumenters(args, out, err):
+  """ Verify the kernel with each race instrumenter in parallel, and report
+      the time taken and the result of each. Every instrumenter is sound, so
+      the kernel is verified if any run verifies it. The result of the
+      fastest run to verify the kernel or, if none does, to find an error is
+      returned, and its output printed """
+  instrumenters = ["original", "watchdog-single", "watchdog-multiple"]
+  results = {}
+
+  def verify(instrumenter):
+    kernel_args = copy.copy(args)
+    kernel_args.benchmark_race_instrumenters = False
+    kernel_args.race_instrumenter = instrumenter
+    # Keep the intermediate files of the runs apart
+    kernel_args.kernel_name = args.kernel_name + "." + instrumenter
+    outFile = tempfile.SpooledTemporaryFile(mode = 'w+')
+    start = timeit.default_timer()
+    try:
+      returnCode = main(kernel_args, outFile, outFile)
+    except Exception as e:
+      print(str(e), file = outFile)
+      returnCode = ErrorCodes.BOOGIE_INTERNAL_ERROR
+    outFile.seek(0)
+    results[instrumenter] = (returnCode, timeit.default_timer() - start,
+                             outFile.read())
+    outFile.close()
+
+  threads = [threading.Thread(target = verify, args = (i, )) \
+             for i in instrumenters]
+  for thread in threads:
+    thread.start()
+  for thread in threads:
+    thread.join()
+
+  definite = [i for i in instrumenters if results[i][0] in \
+              [ErrorCodes.SUCCESS, ErrorCodes.NOT_ALL_VERIFIED]]
+  fastest = min(definite, key = lambda i: results[i][1]) if definite else \
+    "watchdog-single"
+  verified = [i for i in instrumenters if results[i][0] == ErrorCodes.SUCCESS]
+  chosen = min(verified, key = lambda i: results[i][1]) if verified else \
+    fastest
+
+  if args.verbose:
+    for instrumenter in instrumenters:
+      print("Output with race instrumenter " + instrumenter + ":", file = out)
+      print(results[instrumenter][2], end = "", file = out)
+  else:
+    print(results[chosen][2], end = "", file = out)
+
+  pad = max(len(i) for i in instrumenters)
+  print("Race instrumenter benchmark:", file = out)
+  for instrumenter in instrumenters:
+    returnCode, seconds, _ = results[instrumenter]
+    print("- {} : {} ({:.3f} secs)".format(instrumenter.ljust(pad),
+      error_code_name(returnCode), seconds), file = out)
+  if definite:
+    print("Fastest: " + fastest, file = out)
+  return results[chosen][0]
+
 def main(args, out, err):
   """ This wraps GPUVerify's real main function so
       that we can handle exceptions and trigger our own exit
@@ -859,6 +2021,9 @@ def main(args, out, err):
       This is the entry point that should be used if you want
       to use this file as a module rather than as a script.
   """
+  if args.benchmark_race_instrumenters:
+    return benchmark_race_instrumenters(args, out, err)
+
   cleanUpHandler = BatchCaller(args.verbose, out)
   gv_instance = GPUVerifyInstance(args, out, err, cleanUpHandler)
 
@@ -877,6 +2042,8 @@ def main(args, out, err):
 
   try:
     returnCode = gv_instance.invoke()
+    if gv_instance.jsonErrors:
+      gv_instance.writeJSONErrors(returnCode)
   except Exception:
     # Something went very wrong
     doCleanUp(timing = False, exitCode = 0) # It doesn't matter what the exitCode is
@@ -53,6 +53,15 @@ def __positive(string):
 
   return i
 
+def __warp_size(string):
+  i = __positive(string)
+
+  if i & (i - 1) != 0:
+    raise argparse.ArgumentTypeError("warp size {} is not a power of two" \
+      .format(i))
+
+  return i
+
 def __dimensions(string):
   string = string.strip()
 
@@ -145,9 +154,18 @@ def __build_parser(default_solver, version):
   general.add_argument("--loop-unwind=", type = __non_negative, metavar = "X",
     help = "Explore traces that pass through at most X loop heads. Implies \
       --findbugs")
+  general.add_argument("--incremental-loop-unwind=", type = __positive,
+    metavar = "X", help = "Explore traces that pass through at most \
+      --loop-unwind loop heads, then one more loop head on each subsequent \
+      check, up to X loop heads, until a defect is found or --timeout \
+      seconds have elapsed in total. Implies --findbugs")
 
   general.add_argument("--check-array-bounds", action = 'store_true',
     help = "Enable checking for any array out-of-bounds access")
+  general.add_argument("--bounds-check-job", action = 'store_true',
+    help = "Check array bounds in a separate job that runs alongside the race \
+    check, reusing the candidate invariants the race check refutes. Implies \
+    --check-array-bounds. With --solver=portfolio, the job uses z3")
 
   general.add_argument("--no-benign-tolerance", action = 'store_true',
     help = "Do not tolerate benign data races")
@@ -156,6 +174,10 @@ def __build_parser(default_solver, version):
     help = "Only check for barrier divergence, not races")
   general.add_argument("--only-intra-group", action = 'store_true',
     help = "Do not check for inter-group races")
+  general.add_argument("--intra-group-first", action = 'store_true',
+    help = "First check for intra-group races and barrier divergence only, \
+    and stop if these are found. Only then check for inter-group races, \
+    dropping the candidate invariants that the first check refuted")
 
   verbosity = general.add_mutually_exclusive_group()
   verbosity.add_argument("--verbose", action = 'store_true',
@@ -174,6 +196,15 @@ def __build_parser(default_solver, version):
 
   general.add_argument("--error-limit=", type = __positive,
     metavar = "X", help = "Limit the number of errors printed to X.")
+  general.add_argument("--json-errors=", metavar = "X", help = "Also write \
+    the errors found to X as JSON, with the ids of the threads involved, the \
+    conflicting source locations and access offsets, and the values of the \
+    kernel parameters. The file is written for every run, with the verdict")
+  general.add_argument("--replay", action = 'store_true', help = "Replay the \
+    two threads of each data race reported concretely, to confirm the race or \
+    expose it as possibly spurious. Memory not written by the two threads is \
+    read as zero; a replay that depends on it and finds no race is \
+    inconclusive")
 
   language = general.add_mutually_exclusive_group()
   language.add_argument("--opencl", dest = 'source_language',
@@ -225,6 +256,17 @@ def __build_parser(default_solver, version):
     help = "Emit assertions only for the first thread. Sound, and may lead to \
     faster verification, but can yield false positives")
 
+  advanced.add_argument("--symmetry-reduction", action = 'store_true',
+    help = "Only consider pairs of threads where the first thread precedes the \
+    second, ordered by group and local id, when the checks made are the same \
+    for either order. This requires --only-divergence, as races are only \
+    checked in one order. Ignored, with a note under --verbose, otherwise")
+
+  advanced.add_argument("--show-uniformity", action = 'store_true',
+    help = "Report the variables and branches that the uniformity analysis \
+    finds to be the same in all threads. A single copy of such a variable is \
+    kept for both threads, and such a branch is not predicated")
+
   advanced.add_argument("--boogie-file=", type = argparse.FileType('r'),
     default = [], action = 'append', metavar = "X.bpl", help = "Specify a \
     supporting .bpl file to be used during verification")
@@ -243,12 +285,26 @@ def __build_parser(default_solver, version):
   advanced.add_argument("--no-barrier-access-checks", action='store_true',
     help = "Turn off access checks for barrier invariants")
 
+  advanced.add_argument("--simplify-memcpy", action = 'store_true',
+    help = "Simplify memcpy and memset calls, e.g. those resulting from struct \
+    copies, before translation by Bugle. With --verbose, the number of memcpy \
+    calls that remain is reported")
+
+  advanced.add_argument("--native-vectors", action = 'store_true',
+    help = "Treat vector loads, stores and math builtins as single operations \
+    on the whole vector, rather than one per component; for CUDA this models \
+    two- and four-component vector types as native vectors")
+
   advanced.add_argument("--no-inline", action = 'store_true',
     help = "Turn off automatic function inlining")
   advanced.add_argument("--only-log", action = 'store_true',
     help = "Log accesses to arrays, but do not check for races. This can be \
    useful for determining access pattern invariants")
 
+  advanced.add_argument("--elide-read-only-arrays", action = 'store_true',
+    help = "Do not log accesses to or check races on arrays that are never \
+    written by the kernel. Use with --verbose to list the elided arrays")
+
   advanced.add_argument("--kernel-args=", type = __kernel_arguments,
     default = [], action = 'append', metavar = "K,v1,...,vn", help = "For \
     kernel K with scalar parameters x1, ..., xn, add the preconditions \
@@ -258,17 +314,41 @@ def __build_parser(default_solver, version):
     kernel K with array parameters p1, ..., pn, assume that sizeof(p1) == \
     s1, ... sizeof(pn) == sn. Use * to denote an unconstrained size")
 
-  advanced.add_argument("--warp-sync=", type = __positive, metavar = "X",
-    help = "Synchronize threads within warps of size X.")
+  advanced.add_argument("--warp-sync=", type = __warp_size, metavar = "X",
+    help = "Synchronize threads within warps of size X, which must be a power \
+    of two. Lanes are related symbolically, so larger warps, such as 32 or 64, \
+    do not make verification harder")
 
-  advanced.add_argument("--race-instrumenter=", choices = ["original",
-    "watchdog-single", "watchdog-multiple"], default = "watchdog-single",
-    help = "Choose which method of race instrumentation to use. The default is \
-    watchdog-single")
+  advanced.add_argument("--atomic-counters", action = 'store_true',
+    help = "Treat atomic additions of 1 as atomic increments, so that counters \
+    that are only incremented are modelled as monotonic counters")
 
-  advanced.add_argument("--solver=", choices = ["z3", "cvc4"],
+  advanced.add_argument("--race-instrumenter=", choices = ["original",
+    "watchdog-single", "watchdog-multiple", "auto"],
+    default = "watchdog-single", help = "Choose which method of race \
+    instrumentation to use. With auto the method is chosen from the number of \
+    arrays, the accesses per barrier interval and the loops in the kernel. The \
+    default is watchdog-single")
+  advanced.add_argument("--benchmark-race-instrumenters", action = 'store_true',
+    help = "Verify the kernel with each method of race instrumentation in \
+    parallel, and report the time taken and the result of each")
+
+  advanced.add_argument("--parallel-splits=", type = __positive, default = 1,
+    metavar = "X", help = "Split the verification condition of each kernel \
+    after every barrier, and check up to X of the resulting pieces in \
+    parallel. With --verbose, the time taken by each piece is reported")
+  advanced.add_argument("--parallel-arrays=", type = __positive,
+    metavar = "X", help = "Check for races on each array in a separate job, \
+    running up to X jobs in parallel. The result and the time taken are \
+    reported for each array, also when others time out")
+
+  advanced.add_argument("--solver=", choices = ["z3", "cvc4", "portfolio"],
     default = default_solver, help = "Select the SMT solver to use as \
-    backend. Default is {}".format(default_solver))
+    backend. With portfolio, z3 and cvc4 are run concurrently and the first \
+    answer is used. Default is {}".format(default_solver))
+  advanced.add_argument("--portfolio-seeds=", type = __non_negative,
+    default = 0, metavar = "X", help = "Add X z3 configurations with \
+    different random seeds to the portfolio used by --solver=portfolio")
 
   development = parser.add_argument_group("DEVELOPMENT OPTIONS")
   development.add_argument("--debug", action = 'store_true',
@@ -277,7 +357,8 @@ def __build_parser(default_solver, version):
   development.add_argument("--keep-temps", action = 'store_true',
     help = "Keep the intermediate bc, gbpl, and cbpl files")
   development.add_argument("--gen-smt2", action = 'store_true',
-    help = "Generate an smt2 file")
+    help = "Generate an smt2 file. Use gvsmt2.py to split it into queries \
+    and replay these")
 
   development.add_argument("--clang-opt=", dest = 'clang_options', default = [],
     action = 'append', help = "Specify option to be passed to Clang")
@@ -311,8 +392,20 @@ def __build_parser(default_solver, version):
     metavar = "X", help = "Do not generate invariants of type 'X'")
   inference.add_argument("--infer-info", action = 'store_true',
     help = "Prints information about the invariant inference process")
+  inference.add_argument("--parallel-inference=", type = __positive,
+    default = 1, metavar = "X", help = "Run X Houdini instances in parallel, \
+    with different error limits, sharing the candidates each refutes")
+  inference.add_argument("--houdini-cache=", metavar = "X", help = "Use the \
+    JSON file 'X' as a cache of the candidate invariants proven and refuted \
+    by previous runs. Candidates refuted before are dropped before invariant \
+    inference")
   inference.add_argument("--k-induction-depth=", type = __positive, default = 0,
     metavar = "X", help = "Applies k-induction with k=X to all loops")
+  inference.add_argument("--adaptive-k-induction=", type = __positive,
+    metavar = "X", help = "If the kernel cannot be verified, retry with \
+    k-induction for k=1, ..., X in turn until it is verified")
+  inference.add_argument("--parallel-k-induction", action = 'store_true',
+    help = "Try all depths of --adaptive-k-induction at the same time")
 
   json = parser.add_argument_group("JSON MODE")
   json.add_argument("--json", action = 'store_true', help = "The kernels to be \
@@ -416,6 +509,9 @@ def parse_arguments(argv, default_solver, llvm_bin_dir, version):
   parser = __build_parser(default_solver, version)
   args = __to_ldict(parser.parse_args(argv))
 
+  if args.incremental_loop_unwind and not args.loop_unwind:
+    args.loop_unwind = 1
+
   if not args.loop_unwind and not args.mode:
     args.mode = AnalysisMode.ALL
   elif args.loop_unwind:
@@ -426,6 +522,10 @@ def parse_arguments(argv, default_solver, llvm_bin_dir, version):
   if args.version:
     return args
 
+  if args.incremental_loop_unwind and \
+     args.incremental_loop_unwind < args.loop_unwind:
+    parser.error("--incremental-loop-unwind must be at least --loop-unwind")
+
   if args.json:
     if args.group_size or args.num_groups or \
        args.global_size or args.global_offset:
@@ -449,4 +549,51 @@ def parse_arguments(argv, default_solver, llvm_bin_dir, version):
   args.num_groups = __get_num_groups(args, parser)
   __check_global_offset(args, parser)
 
+  if args.intra_group_first and (args.only_intra_group or
+                                 args.only_divergence):
+    parser.error("--intra-group-first cannot be combined with " +
+      "--only-intra-group or --only-divergence")
+
+  if args.intra_group_first and args.kernel_ext in [".bpl", ".cbpl"]:
+    parser.error("--intra-group-first requires a kernel that has not been " +
+      "processed by GPUVerifyVCGen")
+
+  if args.bounds_check_job:
+    args.check_array_bounds = True
+
+  if args.bounds_check_job and args.kernel_ext in [".bpl", ".cbpl"]:
+    parser.error("--bounds-check-job requires a kernel that has not been " +
+      "processed by GPUVerifyVCGen")
+
+  # The jobs run a single check of their own program, so these options, which
+  # change how the check of the program produced by GPUVerifyVCGen is run or
+  # reported, would be ignored by them
+  jobOptions = [("--parallel-splits", args.parallel_splits > 1),
+                ("--adaptive-k-induction", args.adaptive_k_induction),
+                ("--incremental-loop-unwind", args.incremental_loop_unwind)]
+  arrayJobOptions = jobOptions + [
+    ("--solver=portfolio", args.solver == "portfolio"),
+    ("--json-errors", args.json_errors), ("--replay", args.replay),
+    ("--houdini-cache", args.houdini_cache)]
+
+  for option, given in arrayJobOptions:
+    if args.parallel_arrays and given:
+      parser.error("--parallel-arrays cannot be combined with " + option)
+
+  for option, given in jobOptions:
+    if args.bounds_check_job and given:
+      parser.error("--bounds-check-job cannot be combined with " + option)
+
+  # The runs of the benchmark are concurrent, so they would overwrite these
+  for option, given in [("--json-errors", args.json_errors),
+                        ("--houdini-cache", args.houdini_cache)]:
+    if args.benchmark_race_instrumenters and given:
+      parser.error("--benchmark-race-instrumenters cannot be combined with " +
+        option)
+
+  if args.benchmark_race_instrumenters and args.kernel_ext in \
+     [".bc", ".opt.bc", ".gbpl", ".bpl", ".cbpl"]:
+    parser.error("--benchmark-race-instrumenters requires a kernel source " +
+      "file, as the kernel is instrumented by Bugle")
+
   return args
@@ -0,0 +1,278 @@
+"""Module for lightweight analyses of the Boogie files produced by Bugle."""
+
+import hashlib
+import re
+
+__array_decl = re.compile(r"^\s*var\s+((?:\{:[^}]*\}\s*)*)\$\$([\w.$#'~^?]+)\s*:")
+__attribute = re.compile(r"\{:(\w+)\s*([^}]*)\}")
+__array_ref = re.compile(r"\$\$([\w.$#'~^?]+)")
+__identifier = re.compile(r"[\w.$#'~^?]+")
+__existential_decl = re.compile(r"^\s*const\s+(?:\{:[^}]*\}\s*)*" \
+  r"\{:existential\s+true\}\s*(?:\{:[^}]*\}\s*)*([\w.$#'~^?]+)\s*:\s*bool\s*;")
+__declaration = re.compile(r"^(procedure|implementation)\s+(?:\{:[^}]*\}\s*)*" \
+  r"([\w.$#'~^?]+)")
+__call = re.compile(r"^\s*call\s+(?:\{:[^}]*\}\s*)*" \
+  r"(?:[\w.$#'~^?,\s]+:=\s*)?([\w.$#'~^?]+)\s*\(")
+__label = re.compile(r"^\s*([\w.$#'~^?]+):\s*$")
+__goto = re.compile(r"^\s*goto\s+([^;]*);")
+__guarded = re.compile(r"^\s*(?:free\s+)?(assert|requires|ensures|invariant)\s+" \
+  r"(?:\{:[^}]*\}\s*)*([\w.$#'~^?]+)\s*==>\s*(.*?)\s*;\s*$")
+__cas = re.compile(r"\{:atomic_function\s+\"[^\"]*(?:cmpxchg|CAS)[^\"]*\"\}")
+__global_var = re.compile(r"^var\s+(?:\{:[^}]*\}\s*)*([\w.$#'~^?]+)\s*:")
+__log_call = re.compile(r"^\s*call\s+(?:\{:[^}]*\}\s*)*" \
+  r"_LOG_(READ|WRITE|ATOMIC)_\$\$([\w.$#'~^?]+)\s*\((.*)\)\s*;\s*$")
+__assigned = re.compile(r"^\s*(?:call\s+(?:\{:[^}]*\}\s*)*)?" \
+  r"([\w.$#'~^?,\s]+):=")
+__havoc = re.compile(r"^\s*havoc\s+([^;]*);")
+__constant_decl = re.compile(r"^const\s+(?:\{:[^}]*\}\s*)*([\w.$#'~^?]+)\s*:" \
+  r"\s*(\w+)\s*;")
+
+class Array(object):
+  """An array declared in a Boogie file, named without the leading $$"""
+  def __init__(self, name, attributes):
+    self.name = name
+    self.attributes = attributes
+
+  @property
+  def source_name(self):
+    return self.attributes.get("source_name", self.name).strip('"')
+
+  @property
+  def memory_space(self):
+    for space in ["global", "group_shared", "constant"]:
+      if space in self.attributes:
+        return space
+    return None
+
+class Candidate(object):
+  """A candidate invariant guarded by the existential constant name. The
+  location identifies the candidate across runs of the Cruncher, and the key
+  additionally identifies the program the candidate occurs in"""
+  def __init__(self, name, line, location, key):
+    self.name = name
+    self.line = line
+    self.location = location
+    self.key = key
+
+def __strip_comment(line):
+  index = line.find("//")
+  return line if index < 0 else line[:index]
+
+def get_arrays(lines):
+  """Return the global, group shared and constant arrays declared in lines"""
+  arrays = []
+  for line in lines:
+    matched = __array_decl.match(line)
+    if not matched:
+      continue
+    attributes = dict((a.group(1), a.group(2).strip()) for a in \
+      __attribute.finditer(matched.group(1)))
+    array = Array(matched.group(2), attributes)
+    if array.memory_space:
+      arrays.append(array)
+  return arrays
+
+def get_written_arrays(lines):
+  """Return the names of the arrays that may be modified in lines. An array is
+  considered modified when it occurs on the left-hand side of an assignment
+  or call, or in a havoc or modifies clause."""
+  written = set()
+  for line in lines:
+    line = __strip_comment(line).strip()
+    if ":=" in line:
+      written.update(__array_ref.findall(line.split(":=", 1)[0]))
+    elif line.startswith("havoc") or line.startswith("modifies"):
+      written.update(__array_ref.findall(line))
+  return written
+
+def __scopes(lines):
+  """Yield (index, declaration, in_implementation, label, line) for each of
+  lines, where declaration is the procedure or implementation the line belongs
+  to, and label is the block the line occurs in"""
+  declaration = None
+  in_implementation = False
+  label = None
+  for index, line in enumerate(lines):
+    matched = __declaration.match(line)
+    if matched:
+      declaration = matched.group(2)
+      in_implementation = matched.group(1) == "implementation"
+      label = None
+    elif in_implementation and line.startswith("}"):
+      in_implementation = False
+    elif not in_implementation and line.strip() and not line[0].isspace():
+      declaration = None
+    elif in_implementation and __label.match(line):
+      label = __label.match(line).group(1)
+    yield index, declaration, in_implementation, label, line
+
+def __guarded_candidates(lines, guards):
+  """Yield (index, guard, location) for each assertion, requires or ensures in
+  lines that is guarded by one of guards"""
+  for index, declaration, _, label, line in __scopes(lines):
+    matched = __guarded.match(__strip_comment(line))
+    if matched and matched.group(2) in guards:
+      yield index, matched.group(2), \
+        (declaration, label, matched.group(1), matched.group(3))
+
+def get_existentials(lines):
+  """Return the names of the existential constants declared in lines"""
+  return set(m.group(1) for m in map(__existential_decl.match, lines) if m)
+
+def get_candidates(lines):
+  """Return the candidate invariants in lines. The key of a candidate hashes
+  its location, the implementation it occurs in and all declarations outside
+  implementations, with the names of existential constants normalised. As
+  Houdini computes the largest set of candidates that holds, candidates with
+  the same key are either all proven or all refuted"""
+  existentials = get_existentials(lines)
+
+  def normalise(line):
+    return __identifier.sub(lambda m: "_b" if m.group(0) in existentials \
+      else m.group(0), __strip_comment(line).strip())
+
+  outside = hashlib.sha1()
+  implementations = {}
+  for _, declaration, in_implementation, _, line in __scopes(lines):
+    digest = implementations.setdefault(declaration, hashlib.sha1()) \
+      if in_implementation else outside
+    digest.update((normalise(line) + "\n").encode("utf-8"))
+
+  candidates = []
+  for index, name, location in __guarded_candidates(lines, existentials):
+    digest = outside.copy()
+    if location[0] in implementations:
+      digest.update(implementations[location[0]].digest())
+    digest.update(repr(location).encode("utf-8"))
+    candidates.append(Candidate(name, index, location, digest.hexdigest()))
+  return candidates
+
+def get_proven_locations(lines):
+  """Return the locations of the candidates in lines, as produced by the
+  Cruncher, that Houdini found to hold; their guards are replaced by true"""
+  return set(location for _, _, location in \
+    __guarded_candidates(lines, ["true"]))
+
+def get_barrier_calls(lines):
+  """Return the indices of the lines that call a barrier, i.e., a procedure
+  with the barrier attribute"""
+  barriers = set()
+  for line in lines:
+    matched = __declaration.match(line)
+    if matched and matched.group(1) == "procedure" and \
+       "{:barrier}" in line[:matched.end()]:
+      barriers.add(matched.group(2))
+
+  calls = []
+  for index, line in enumerate(lines):
+    matched = __call.match(__strip_comment(line))
+    if matched and matched.group(1) in barriers:
+      calls.append(index)
+  return calls
+
+def get_array_accesses(lines, arrays):
+  """Return the number of references to each of arrays, named without the
+  leading $$, in the implementations in lines"""
+  accesses = dict((array, 0) for array in arrays)
+  for _, _, in_implementation, _, line in __scopes(lines):
+    if in_implementation:
+      for array in __array_ref.findall(__strip_comment(line)):
+        if array in accesses:
+          accesses[array] += 1
+  return accesses
+
+def get_loop_heads(lines):
+  """Return the (implementation, label) pairs of the blocks in lines that are
+  the target of a back edge, i.e., a goto to a block that occurs earlier in the
+  same implementation"""
+  heads = set()
+  seen = set()
+  for _, declaration, in_implementation, label, line in __scopes(lines):
+    if not in_implementation:
+      continue
+    seen.add((declaration, label))
+    matched = __goto.match(__strip_comment(line))
+    if matched:
+      heads.update((declaration, target.strip()) for target in \
+        matched.group(1).split(",") if (declaration, target.strip()) in seen)
+  return heads
+
+def __arguments(string):
+  """Split string, the arguments of a call, at the commas outside brackets"""
+  arguments = []
+  depth = 0
+  start = 0
+  for index, char in enumerate(string):
+    if char in "([":
+      depth += 1
+    elif char in ")]":
+      depth -= 1
+    elif char == "," and depth == 0:
+      arguments.append(string[start:index].strip())
+      start = index + 1
+  arguments.append(string[start:].strip())
+  return arguments
+
+class CASLoop(object):
+  """A loop that retries a compare-and-swap. The head is the index of the line
+  labelling the loop head, and accesses the (kind, array, offset) triples of
+  the accesses logged in the loop whose offset the loop does not modify"""
+  def __init__(self, implementation, head, accesses):
+    self.implementation = implementation
+    self.head = head
+    self.accesses = accesses
+
+def get_cas_loops(lines):
+  """Return the loops in lines, as produced by GPUVerifyVCGen, that contain a
+  compare-and-swap. A loop spans the lines from its head to the last goto back
+  to the head, which covers the loops Bugle emits for structured code"""
+  heads = get_loop_heads(lines)
+  starts = {}
+  ends = {}
+  for index, declaration, in_implementation, label, line in __scopes(lines):
+    if not in_implementation:
+      continue
+    if (declaration, label) in heads and label not in starts.get(declaration, {}):
+      starts.setdefault(declaration, {})[label] = index
+    matched = __goto.match(__strip_comment(line))
+    if matched:
+      for target in matched.group(1).split(","):
+        if (declaration, target.strip()) in heads:
+          ends[(declaration, target.strip())] = index
+
+  loops = []
+  for (declaration, label), end in sorted(ends.items()):
+    start = starts[declaration][label]
+    body = [__strip_comment(line) for line in lines[start:end + 1]]
+    if not any(__cas.search(line) for line in body):
+      continue
+
+    modified = set()
+    for line in body:
+      matched = __assigned.match(line) or __havoc.match(line)
+      if matched:
+        modified.update(name.strip() for name in matched.group(1).split(","))
+
+    accesses = []
+    for line in body:
+      matched = __log_call.match(line)
+      if not matched:
+        continue
+      arguments = __arguments(matched.group(3))
+      if len(arguments) < 2 or \
+         modified.intersection(__identifier.findall(arguments[1])):
+        continue
+      access = (matched.group(1), matched.group(2), arguments[1])
+      if access not in accesses:
+        accesses.append(access)
+    loops.append(CASLoop(declaration, start, accesses))
+  return loops
+
+def get_constants(lines):
+  """Return a dictionary from the names of the constants declared in lines to
+  their types"""
+  return dict(m.groups() for m in map(__constant_decl.match, lines) if m)
+
+def get_global_variables(lines):
+  """Return the names of the global variables declared in lines"""
+  return set(m.group(1) for m in map(__global_var.match, lines) if m)
@@ -16,3 +16,10 @@ class ErrorCodes(object):
   BOOGIE_OTHER_ERROR = 12 # Uncategorised failure of Boogie Driver or Cruncher
   # The following is only used by gvtester.
   REGEX_MISMATCH_ERROR = 100
+
+def error_code_name(code):
+  """Return the name of code, e.g., NOT_ALL_VERIFIED"""
+  for name in dir(ErrorCodes):
+    if not name.startswith("_") and getattr(ErrorCodes, name) == code:
+      return name
+  return str(code)
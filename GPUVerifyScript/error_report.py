@@ -0,0 +1,119 @@
+"""Module for parsing the error reports emitted by the BoogieDriver into a form
+that can be written as JSON."""
+
+import re
+
+__location = r"(?P<file>.+?):(?P<line>\d+):(?P<column>\d+)"
+__header = re.compile(r"^" + __location + r": error: (?P<message>.*?):?\s*$")
+__race = re.compile(r"^possible (?P<kind>\w+-\w+) race on (?P<array>[^\s\[(]+)" \
+  r"(?:\[(?P<index>[^\]]*)\])?(?: \((?P<unit>bytes?) (?P<offset>[^)]*)\))?")
+__access = re.compile(r"^(?P<access>Write|Read|Atomic) by (?P<thread>.*), " \
+  + __location + r":\s*$")
+__opencl_thread = re.compile(r"work item (?P<global_id>.+?) with local id " \
+  r"(?P<local_id>.+?) in work group (?P<group_id>\(.*?\)|\d+)")
+__cuda_thread = re.compile(r"thread (?P<local_id>.+?) in thread block " \
+  r"(?P<group_id>\(.*?\)|\d+) \(global id (?P<global_id>\(.*?\)|\d+)\)")
+__parameters = re.compile(r"^Bitwise values of parameters of '(?P<kernel>.*)':")
+__parameter = re.compile(r"^\s+(?P<name>\S+) = (?P<value>\S+)" \
+  r"(?: \((?P<interpretation>.*)\))?\s*$")
+
+def __location_of(matched):
+  return { "file": matched.group("file"), "line": int(matched.group("line")),
+           "column": int(matched.group("column")) }
+
+def __id(string):
+  """Turn a thread or group id such as 5 or (1, 2) into a list of integers"""
+  try:
+    return [int(i) for i in string.strip("()").split(",")]
+  except ValueError:
+    return string
+
+def __thread(description):
+  """Return the ids of the thread described, or None if there is none"""
+  for pattern in [__opencl_thread, __cuda_thread]:
+    matched = pattern.search(description)
+    if matched:
+      return dict((key, __id(value)) for key, value in \
+        matched.groupdict().items())
+  return None
+
+def __error(matched):
+  message = matched.group("message")
+  error = { "message": message, "location": __location_of(matched) }
+  race = __race.match(message)
+  if race:
+    error["kind"] = "race"
+    error["race"] = { "kind": race.group("kind"), "array": race.group("array") }
+    if race.group("index") is not None:
+      error["race"]["index"] = race.group("index")
+    if race.group("offset") is not None:
+      error["race"][race.group("unit")] = race.group("offset")
+    error["accesses"] = []
+  elif message.startswith("possible array out-of-bounds access"):
+    error["kind"] = "array_bounds"
+  elif message.startswith("barrier may be reached by non-uniform control"):
+    error["kind"] = "barrier_divergence"
+  elif "assert" in message or "invariant" in message or \
+       "postcondition" in message or "precondition" in message:
+    error["kind"] = "assertion"
+  else:
+    error["kind"] = "other"
+  thread = __thread(message)
+  if thread:
+    error["thread"] = thread
+  return error
+
+def parse_error_report(output):
+  """Return the errors reported in output, the output of the BoogieDriver. Each
+  error records its kind and source location, the kernel parameter values
+  reported for it and, for races, the conflicting accesses with the ids of the
+  threads performing them"""
+  errors = []
+  error = None
+  parameters = None
+  code = None
+  for line in output.splitlines():
+    matched = __header.match(line)
+    if matched:
+      error = __error(matched)
+      errors.append(error)
+      parameters = code = None
+      continue
+    if error is None:
+      continue
+
+    matched = __access.match(line)
+    if matched and "accesses" in error:
+      access = { "access": matched.group("access"),
+                 "location": __location_of(matched) }
+      thread = __thread(matched.group("thread"))
+      if thread:
+        access["thread"] = thread
+      error["accesses"].append(access)
+      parameters = None
+      code = access
+      continue
+
+    matched = __parameters.match(line)
+    if matched:
+      error["kernel"] = matched.group("kernel")
+      parameters = error.setdefault("parameters", {})
+      code = None
+      continue
+
+    matched = __parameter.match(line)
+    if matched and parameters is not None:
+      parameters[matched.group("name")] = { "value": matched.group("value") }
+      if matched.group("interpretation") is not None:
+        parameters[matched.group("name")]["interpretation"] = \
+          matched.group("interpretation")
+      continue
+
+    if not line.strip():
+      code = None
+    elif code is not None and "code" not in code:
+      code["code"] = line.strip()
+    else:
+      parameters = None
+
+  return errors
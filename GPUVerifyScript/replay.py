@@ -0,0 +1,897 @@
+"""Module for replaying the two threads of a reported data race concretely. The
+threads are executed by interpreting the Boogie program produced by Bugle,
+which translates the kernel bitcode one-to-one, so none of the abstractions
+applied by GPUVerifyVCGen are involved. A race is confirmed when the two threads
+access the same array element in the same barrier interval, and at least one
+of the accesses is a write. Memory not written by the threads is read as zero;
+as the verifier treats it as arbitrary, a replay that reads such memory and
+finds no race is inconclusive. So is a replay of values for which a
+precondition of the kernel does not hold, or cannot be checked."""
+
+import re
+from collections import namedtuple
+
+class ReplayError(Exception):
+  """Raised when a replay is inconclusive, e.g., because the program depends on
+  a value that is not known concretely"""
+  def __init__(self, msg):
+    self.msg = msg
+
+  def __str__(self):
+    return self.msg
+
+BV = namedtuple("BV", ["value", "width"])
+
+Access = namedtuple("Access", ["thread", "array", "index", "kind", "interval"])
+
+class Replay(object):
+  """The outcome of a replay: verdict is one of confirmed, not reproduced or
+  inconclusive; reason explains the verdict"""
+  def __init__(self, verdict, reason):
+    self.verdict = verdict
+    self.reason = reason
+
+# Parsing
+
+_token = re.compile(r"\s+|//[^\n]*|/\*.*?\*/|(?P<token>\{:|\"[^\"]*\"|" \
+  r"\d+bv\d+|\d+|[A-Za-z_$.#'~^?\\][\w$.#'~^?\\]*|<==>|==>|<==|::|:=|==|" \
+  r"!=|<=|>=|&&|\|\||\+\+|<:|[<>=+\-*/%!()\[\]{},;:|])", re.DOTALL)
+
+def _tokenise(text):
+  tokens = []
+  position = 0
+  while position < len(text):
+    matched = _token.match(text, position)
+    if not matched:
+      raise ReplayError("cannot parse '" + text[position:position + 20] + "'")
+    if matched.group("token"):
+      tokens.append(matched.group("token"))
+    position = matched.end()
+  return tokens
+
+Procedure = namedtuple("Procedure",
+  ["name", "attributes", "parameters", "returns", "requires"])
+Implementation = namedtuple("Implementation",
+  ["name", "attributes", "parameters", "returns", "locals", "body", "labels"])
+Function = namedtuple("Function",
+  ["name", "attributes", "parameters", "type", "body"])
+Variable = namedtuple("Variable", ["name", "attributes", "type"])
+
+class _Parser(object):
+  """Recursive descent parser for the subset of Boogie emitted by Bugle"""
+  def __init__(self, tokens):
+    self.tokens = tokens
+    self.position = 0
+
+  def peek(self, offset = 0):
+    index = self.position + offset
+    return self.tokens[index] if index < len(self.tokens) else None
+
+  def next(self):
+    token = self.peek()
+    if token is None:
+      raise ReplayError("unexpected end of file")
+    self.position += 1
+    return token
+
+  def expect(self, token):
+    if self.next() != token:
+      raise ReplayError("expected '" + token + "' but found '" + \
+        self.tokens[self.position - 1] + "'")
+
+  def accept(self, token):
+    if self.peek() == token:
+      self.position += 1
+      return True
+    return False
+
+  def skip_to(self, token):
+    """Skip past the next occurrence of token outside brackets"""
+    depth = 0
+    while True:
+      current = self.next()
+      if current == token and depth == 0:
+        return
+      if current in ["(", "[", "{", "{:"]:
+        depth += 1
+      elif current in [")", "]", "}"]:
+        depth -= 1
+
+  def attributes(self):
+    attributes = {}
+    while self.accept("{:"):
+      name = self.next()
+      values = []
+      while self.peek() != "}":
+        if self.peek() == ",":
+          self.next()
+        else:
+          values.append(self.expression())
+      self.expect("}")
+      attributes[name] = values
+    return attributes
+
+  def type(self):
+    if self.accept("["):
+      self.skip_to("]")
+      return ("map", self.type())
+    return self.next()
+
+  def typed_identifiers(self, close):
+    """Parse a list of identifiers with types up to close, e.g., parameters.
+    Unnamed parameters are given as their type only"""
+    variables = []
+    while not self.accept(close):
+      self.accept(",")
+      attributes = self.attributes()
+      if self.peek() == "[":
+        variables.append(Variable(None, attributes, self.type()))
+        continue
+      names = [self.next()]
+      while self.peek() == "," and self.peek(2) in [",", ":"]:
+        self.next()
+        names.append(self.next())
+      if self.accept(":"):
+        variable_type = self.type()
+      else:
+        variable_type, names = names[0], [None]
+      variables += [Variable(n, attributes, variable_type) for n in names]
+    return variables
+
+  def program(self):
+    program = { "types": {}, "variables": {}, "constants": {},
+                "functions": {}, "procedures": {}, "implementations": {} }
+    while self.peek() is not None:
+      keyword = self.next()
+      if keyword == "type":
+        self.attributes()
+        name = self.next()
+        if self.accept("="):
+          program["types"][name] = self.type()
+          self.expect(";")
+        else:
+          self.skip_to(";")
+      elif keyword == "var":
+        attributes = self.attributes()
+        for variable in self.typed_identifiers(";"):
+          program["variables"][variable.name] = \
+            Variable(variable.name, attributes, variable.type)
+      elif keyword == "const":
+        attributes = self.attributes()
+        self.accept("unique")
+        for variable in self.typed_identifiers(";"):
+          program["constants"][variable.name] = \
+            Variable(variable.name, attributes, variable.type)
+      elif keyword == "function":
+        function = self.function()
+        program["functions"][function.name] = function
+      elif keyword == "procedure":
+        procedure = self.procedure()
+        program["procedures"][procedure.name] = procedure
+      elif keyword == "implementation":
+        implementation = self.implementation()
+        program["implementations"][implementation.name] = implementation
+      else:
+        self.skip_to(";")
+    return program
+
+  def function(self):
+    attributes = self.attributes()
+    name = self.next()
+    self.expect("(")
+    parameters = self.typed_identifiers(")")
+    if self.accept("returns"):
+      self.expect("(")
+      result_type = self.typed_identifiers(")")[0].type
+    else:
+      self.expect(":")
+      result_type = self.type()
+    body = None
+    if self.accept("{"):
+      body = self.expression()
+      self.expect("}")
+    else:
+      self.expect(";")
+    return Function(name, attributes, parameters, result_type, body)
+
+  def signature(self):
+    attributes = self.attributes()
+    name = self.next()
+    self.expect("(")
+    parameters = self.typed_identifiers(")")
+    returns = []
+    if self.accept("returns"):
+      self.expect("(")
+      returns = self.typed_identifiers(")")
+    return attributes, name, parameters, returns
+
+  def procedure(self):
+    attributes, name, parameters, returns = self.signature()
+    self.accept(";")
+    requires = []
+    while self.peek() in ["free", "requires", "ensures", "modifies"]:
+      self.accept("free")
+      if not self.accept("requires"):
+        self.skip_to(";")
+        continue
+      # An unsupported precondition is kept as None, so that a replay relying
+      # on it is inconclusive
+      start = self.position
+      try:
+        self.attributes()
+        requires.append(self.expression())
+        self.expect(";")
+      except ReplayError:
+        self.position = start
+        self.skip_to(";")
+        requires.append(None)
+    return Procedure(name, attributes, parameters, returns, requires)
+
+  def implementation(self):
+    attributes, name, parameters, returns = self.signature()
+    self.expect("{")
+    local_variables = []
+    while self.accept("var"):
+      self.attributes()
+      local_variables += self.typed_identifiers(";")
+    body = []
+    labels = {}
+    while not self.accept("}"):
+      if self.peek(1) == ":" and self.peek() not in \
+         ["assert", "assume", "call", "goto", "havoc", "return"]:
+        labels[self.next()] = len(body)
+        self.next()
+      else:
+        body.append(self.statement())
+    return Implementation(name, attributes, parameters, returns,
+                          local_variables, body, labels)
+
+  def statement(self):
+    keyword = self.peek()
+    if keyword in ["assert", "assume"]:
+      self.next()
+      attributes = self.attributes()
+      statement = (keyword, attributes, self.expression())
+    elif keyword == "havoc":
+      self.next()
+      statement = ("havoc", self.identifiers())
+    elif keyword == "goto":
+      self.next()
+      statement = ("goto", self.identifiers())
+    elif keyword == "return":
+      self.next()
+      statement = ("return",)
+    elif keyword == "call":
+      self.next()
+      attributes = self.attributes()
+      targets = []
+      if self.peek(1) in [",", ":="]:
+        targets = self.identifiers()
+        self.expect(":=")
+      name = self.next()
+      self.expect("(")
+      statement = ("call", attributes, targets, name, self.arguments(")"))
+    elif keyword in ["if", "while", "break"]:
+      raise ReplayError("structured statements are not supported")
+    else:
+      targets = [self.target()]
+      while self.accept(","):
+        targets.append(self.target())
+      self.expect(":=")
+      values = [self.expression()]
+      while self.accept(","):
+        values.append(self.expression())
+      statement = ("assign", targets, values)
+    self.expect(";")
+    return statement
+
+  def identifiers(self):
+    identifiers = [self.next()]
+    while self.accept(","):
+      identifiers.append(self.next())
+    return identifiers
+
+  def arguments(self, close):
+    arguments = []
+    while not self.accept(close):
+      self.accept(",")
+      arguments.append(self.expression())
+    return arguments
+
+  def target(self):
+    name = self.next()
+    indices = []
+    while self.accept("["):
+      indices.append(self.expression())
+      self.expect("]")
+    return (name, indices)
+
+  # Expressions, from the loosest to the tightest binding operators
+
+  def expression(self):
+    left = self.implication()
+    while self.accept("<==>"):
+      left = ("binary", "<==>", left, self.implication())
+    return left
+
+  def implication(self):
+    left = self.logical()
+    if self.accept("==>"):
+      return ("binary", "==>", left, self.implication())
+    return left
+
+  def logical(self):
+    left = self.relation()
+    while self.peek() in ["&&", "||"]:
+      left = ("binary", self.next(), left, self.relation())
+    return left
+
+  def relation(self):
+    left = self.concatenation()
+    if self.peek() in ["==", "!=", "<", "<=", ">", ">="]:
+      return ("binary", self.next(), left, self.concatenation())
+    return left
+
+  def concatenation(self):
+    left = self.additive()
+    while self.accept("++"):
+      left = ("binary", "++", left, self.additive())
+    return left
+
+  def additive(self):
+    left = self.multiplicative()
+    while self.peek() in ["+", "-"]:
+      left = ("binary", self.next(), left, self.multiplicative())
+    return left
+
+  def multiplicative(self):
+    left = self.unary()
+    while self.peek() in ["*", "div", "mod"]:
+      left = ("binary", self.next(), left, self.unary())
+    return left
+
+  def unary(self):
+    if self.peek() in ["!", "-"]:
+      return ("unary", self.next(), self.unary())
+    return self.postfix()
+
+  def postfix(self):
+    expression = self.primary()
+    while self.accept("["):
+      first = self.expression()
+      if self.accept(":"):
+        expression = ("extract", expression, first, self.expression())
+      else:
+        expression = ("select", expression, first)
+      self.expect("]")
+    return expression
+
+  def primary(self):
+    token = self.next()
+    if token == "(":
+      expression = self.expression()
+      self.expect(")")
+      return expression
+    if token in ["true", "false"]:
+      return ("literal", token == "true")
+    if token == "if":
+      condition = self.expression()
+      self.expect("then")
+      then = self.expression()
+      self.expect("else")
+      return ("ite", condition, then, self.expression())
+    if "bv" in token and token[0].isdigit():
+      value, width = token.split("bv")
+      return ("literal", BV(int(value), int(width)))
+    if token.isdigit():
+      return ("literal", int(token))
+    if token in ["forall", "exists", "old"]:
+      raise ReplayError("'" + token + "' is not supported")
+    if self.accept("("):
+      return ("apply", token, self.arguments(")"))
+    return ("variable", token)
+
+def _resolve(types, variable_type):
+  if isinstance(variable_type, tuple):
+    return ("map", _resolve(types, variable_type[1]))
+  while variable_type in types:
+    variable_type = types[variable_type]
+  return variable_type
+
+def parse_program(text):
+  """Parse text, a Boogie program produced by Bugle"""
+  program = _Parser(_tokenise(text)).program()
+  types = program["types"]
+
+  def resolve(variables):
+    return [v._replace(type = _resolve(types, v.type)) for v in variables]
+
+  for kind in ["variables", "constants"]:
+    for name, variable in program[kind].items():
+      program[kind][name] = resolve([variable])[0]
+  for name, i in program["implementations"].items():
+    program["implementations"][name] = i._replace(
+      parameters = resolve(i.parameters), returns = resolve(i.returns),
+      locals = resolve(i.locals))
+  return program
+
+# Evaluation
+
+def _mask(width):
+  return (1 << width) - 1
+
+def _signed(bv):
+  if bv.value >> (bv.width - 1):
+    return bv.value - (1 << bv.width)
+  return bv.value
+
+def _bv(value, width):
+  return BV(value & _mask(width), width)
+
+def _udiv(a, b):
+  return _bv(a.value // b.value if b.value else _mask(a.width), a.width)
+
+def _urem(a, b):
+  return _bv(a.value % b.value if b.value else a.value, a.width)
+
+def _sdiv(a, b):
+  if not b.value:
+    return _bv(1 if _signed(a) < 0 else -1, a.width)
+  quotient = abs(_signed(a)) // abs(_signed(b))
+  return _bv(quotient if (_signed(a) < 0) == (_signed(b) < 0) \
+    else -quotient, a.width)
+
+def _srem(a, b):
+  if not b.value:
+    return a
+  remainder = abs(_signed(a)) % abs(_signed(b))
+  return _bv(-remainder if _signed(a) < 0 else remainder, a.width)
+
+def _shift(a, b, operation):
+  return _bv(operation(a, min(b.value, a.width)), a.width)
+
+_builtins = {
+  "bvadd": lambda a, b: _bv(a.value + b.value, a.width),
+  "bvsub": lambda a, b: _bv(a.value - b.value, a.width),
+  "bvmul": lambda a, b: _bv(a.value * b.value, a.width),
+  "bvudiv": _udiv,
+  "bvurem": _urem,
+  "bvsdiv": _sdiv,
+  "bvsrem": _srem,
+  "bvand": lambda a, b: BV(a.value & b.value, a.width),
+  "bvor": lambda a, b: BV(a.value | b.value, a.width),
+  "bvxor": lambda a, b: BV(a.value ^ b.value, a.width),
+  "bvnot": lambda a: _bv(~a.value, a.width),
+  "bvneg": lambda a: _bv(-a.value, a.width),
+  "bvshl": lambda a, b: _shift(a, b, lambda x, y: x.value << y),
+  "bvlshr": lambda a, b: _shift(a, b, lambda x, y: x.value >> y),
+  "bvashr": lambda a, b: _shift(a, b, lambda x, y: _signed(x) >> y),
+  "bvult": lambda a, b: a.value < b.value,
+  "bvule": lambda a, b: a.value <= b.value,
+  "bvugt": lambda a, b: a.value > b.value,
+  "bvuge": lambda a, b: a.value >= b.value,
+  "bvslt": lambda a, b: _signed(a) < _signed(b),
+  "bvsle": lambda a, b: _signed(a) <= _signed(b),
+  "bvsgt": lambda a, b: _signed(a) > _signed(b),
+  "bvsge": lambda a, b: _signed(a) >= _signed(b),
+}
+
+_binary = {
+  "==": lambda a, b: a == b,
+  "!=": lambda a, b: a != b,
+  "<": lambda a, b: a < b,
+  "<=": lambda a, b: a <= b,
+  ">": lambda a, b: a > b,
+  ">=": lambda a, b: a >= b,
+  "+": lambda a, b: a + b,
+  "-": lambda a, b: a - b,
+  "*": lambda a, b: a * b,
+  "div": lambda a, b: a // b,
+  "mod": lambda a, b: a % b,
+  "++": lambda a, b: BV((a.value << b.width) | b.value, a.width + b.width),
+}
+
+def _width(variable_type):
+  if isinstance(variable_type, str) and variable_type.startswith("bv"):
+    return int(variable_type[2:])
+  return None
+
+def _default(variable_type):
+  """The value memory and variables of variable_type are assumed to start
+  with"""
+  if isinstance(variable_type, tuple):
+    return {}
+  if variable_type == "bool":
+    return False
+  if variable_type == "int":
+    return 0
+  if _width(variable_type) is not None:
+    return BV(0, _width(variable_type))
+  raise ReplayError("values of type " + str(variable_type) + \
+    " are not supported")
+
+def _builtin(function):
+  if "bvbuiltin" not in function.attributes:
+    return None
+  name = function.attributes["bvbuiltin"][0][1].strip('"') \
+    if function.attributes["bvbuiltin"] else ""
+  if name in _builtins:
+    return _builtins[name]
+  matched = re.match(r"(zero|sign)_extend (\d+)$", name)
+  if matched:
+    extension = int(matched.group(2))
+    if matched.group(1) == "zero":
+      return lambda a: BV(a.value, a.width + extension)
+    return lambda a: _bv(_signed(a), a.width + extension)
+  return None
+
+class _Thread(object):
+  """One of the two threads replayed"""
+  def __init__(self, number, constants, memory):
+    self.number = number
+    self.constants = constants
+    self.memory = memory
+    self.frames = []
+    self.steps = 0
+
+class _Interpreter(object):
+  def __init__(self, program, array, max_steps):
+    self.program = program
+    self.array = array
+    self.max_steps = max_steps
+    self.interval = 0
+    self.accesses = []
+    self.unwritten = set()
+
+  def is_shared_array(self, name):
+    variable = self.program["variables"].get(name)
+    return variable is not None and name.startswith("$$") and \
+      any(space in variable.attributes for space in \
+        ["global", "group_shared", "constant"])
+
+  def source_name(self, name):
+    variable = self.program["variables"][name]
+    if "source_name" in variable.attributes:
+      return variable.attributes["source_name"][0][1].strip('"')
+    return name[2:]
+
+  def record(self, thread, name, index, kind):
+    if self.is_shared_array(name):
+      self.accesses.append(Access(thread.number, self.source_name(name),
+        index.value if isinstance(index, BV) else index, kind, self.interval))
+
+  def lookup(self, thread, name):
+    environment = thread.frames[-1]["environment"]
+    if name in environment:
+      return environment[name]
+    if name in thread.memory:
+      return thread.memory[name]
+    if name in thread.constants:
+      return thread.constants[name]
+    raise ReplayError("the value of '" + name + "' is not known")
+
+  def evaluate(self, thread, expression, environment = None):
+    kind = expression[0]
+    if kind == "literal":
+      return expression[1]
+    if kind == "variable":
+      if environment is not None and expression[1] in environment:
+        return environment[expression[1]]
+      return self.lookup(thread, expression[1])
+    if kind == "select":
+      if expression[1][0] != "variable":
+        raise ReplayError("nested map selections are not supported")
+      name = expression[1][1]
+      index = self.evaluate(thread, expression[2], environment)
+      self.record(thread, name, index, "read")
+      array = self.lookup(thread, name)
+      if index in array:
+        return array[index]
+      self.unwritten.add(self.source_name(name) \
+        if name in self.program["variables"] else name)
+      return _default(self.array_type(name))
+    if kind == "extract":
+      value = self.evaluate(thread, expression[1], environment)
+      high = self.evaluate(thread, expression[2], environment)
+      low = self.evaluate(thread, expression[3], environment)
+      return BV((value.value >> low) & _mask(high - low), high - low)
+    if kind == "unary":
+      value = self.evaluate(thread, expression[2], environment)
+      return not value if expression[1] == "!" else -value
+    if kind == "ite":
+      if self.evaluate(thread, expression[1], environment):
+        return self.evaluate(thread, expression[2], environment)
+      return self.evaluate(thread, expression[3], environment)
+    if kind == "binary":
+      operator = expression[1]
+      left = self.evaluate(thread, expression[2], environment)
+      if operator == "&&" and not left:
+        return False
+      if operator == "||" and left:
+        return True
+      if operator == "==>" and not left:
+        return True
+      right = self.evaluate(thread, expression[3], environment)
+      if operator in ["&&", "||", "==>"]:
+        return right
+      if operator == "<==>":
+        return left == right
+      return _binary[operator](left, right)
+    if kind == "apply":
+      return self.apply(thread, expression[1], [self.evaluate(thread, a,
+        environment) for a in expression[2]])
+    assert False
+
+  def apply(self, thread, name, arguments):
+    function = self.program["functions"].get(name)
+    if function is None:
+      raise ReplayError("function '" + name + "' is not declared")
+    if function.body is not None:
+      return self.evaluate(thread, function.body,
+        dict(zip([p.name for p in function.parameters], arguments)))
+    builtin = _builtin(function)
+    if builtin is None:
+      raise ReplayError("function '" + name + "' is uninterpreted")
+    return builtin(*arguments)
+
+  def array_type(self, name):
+    variable = self.program["variables"].get(name)
+    if variable is None:
+      for frame_variable in self.current_locals:
+        if frame_variable.name == name:
+          variable = frame_variable
+    if variable is None or not isinstance(variable.type, tuple):
+      raise ReplayError("'" + name + "' is not an array")
+    return variable.type[1]
+
+  def enter(self, thread, implementation, arguments):
+    environment = dict(zip([p.name for p in implementation.parameters],
+                           arguments))
+    for variable in implementation.returns + implementation.locals:
+      environment[variable.name] = _default(variable.type)
+    thread.frames.append({ "implementation": implementation, "pc": 0,
+                           "environment": environment, "targets": None })
+
+  def check_requires(self, thread, procedure, arguments):
+    """Check the preconditions of procedure for thread, before it has written
+    any memory"""
+    environment = dict(zip([p.name for p in procedure.parameters], arguments))
+    self.current_locals = []
+    for condition in procedure.requires:
+      if condition is None:
+        raise ReplayError("a precondition of the kernel is not supported")
+      recorded = len(self.accesses)
+      holds = self.evaluate(thread, condition, environment)
+      del self.accesses[recorded:]
+      if self.unwritten:
+        raise ReplayError("a precondition of the kernel depends on the " + \
+          "initial values of " + ", ".join(sorted(self.unwritten)) + \
+          ", which are not known")
+      if not holds:
+        raise ReplayError("a precondition of the kernel does not hold for " + \
+          "the values replayed")
+
+  def assign(self, thread, name, indices, value):
+    environment = thread.frames[-1]["environment"]
+    scope = environment if name in environment else thread.memory
+    if name not in scope:
+      raise ReplayError("cannot assign to '" + name + "'")
+    if not indices:
+      scope[name] = value
+      return
+    if len(indices) > 1:
+      raise ReplayError("multi-dimensional arrays are not supported")
+    self.record(thread, name, indices[0], "write")
+    scope[name][indices[0]] = value
+
+  def feasible(self, thread, implementation, label):
+    """Whether the assumptions at the start of block label hold"""
+    index = implementation.labels[label]
+    recorded = len(self.accesses)
+    try:
+      while index < len(implementation.body) and \
+            implementation.body[index][0] == "assume":
+        if not self.evaluate(thread, implementation.body[index][2]):
+          return False
+        index += 1
+      return True
+    finally:
+      # The accesses are recorded again if the block is executed
+      del self.accesses[recorded:]
+
+  def run(self, thread):
+    """Run thread until it reaches a barrier or finishes. Returns whether a
+    barrier was reached"""
+    while thread.frames:
+      thread.steps += 1
+      if thread.steps > self.max_steps:
+        raise ReplayError("thread " + str(thread.number) + " did not " + \
+          "finish within " + str(self.max_steps) + " steps")
+
+      frame = thread.frames[-1]
+      implementation = frame["implementation"]
+      if frame["pc"] >= len(implementation.body):
+        raise ReplayError("control reaches the end of '" + \
+          implementation.name + "'")
+      self.current_locals = implementation.locals + implementation.returns
+      statement = implementation.body[frame["pc"]]
+      frame["pc"] += 1
+      kind = statement[0]
+
+      if kind == "assert":
+        continue
+      elif kind == "assume":
+        if not self.evaluate(thread, statement[2]):
+          raise ReplayError("an assumption of the kernel does not hold " + \
+            "for the values replayed")
+      elif kind == "havoc":
+        raise ReplayError("the kernel uses nondeterministic values")
+      elif kind == "goto":
+        feasible = [l for l in statement[1] \
+          if self.feasible(thread, implementation, l)]
+        if not feasible:
+          raise ReplayError("no branch is feasible for the values replayed")
+        frame["pc"] = implementation.labels[feasible[0]]
+      elif kind == "assign":
+        values = [self.evaluate(thread, v) for v in statement[2]]
+        for (name, indices), value in zip(statement[1], values):
+          self.assign(thread, name,
+            [self.evaluate(thread, i) for i in indices], value)
+      elif kind == "call":
+        _, attributes, targets, name, arguments = statement
+        values = [self.evaluate(thread, a) for a in arguments]
+        procedure = self.program["procedures"].get(name)
+        if procedure is not None and "barrier" in procedure.attributes:
+          return True
+        if "atomic" in attributes:
+          raise ReplayError("atomic operations are not replayed")
+        if name not in self.program["implementations"]:
+          raise ReplayError("procedure '" + name + "' has no implementation")
+        frame["targets"] = targets
+        self.enter(thread, self.program["implementations"][name], values)
+      elif kind == "return":
+        returns = [frame["environment"][r.name] for r in implementation.returns]
+        thread.frames.pop()
+        if thread.frames:
+          caller = thread.frames[-1]
+          for target, value in zip(caller["targets"], returns):
+            self.assign(thread, target, [], value)
+    return False
+
+  def conflict(self, different_groups):
+    """Return a pair of conflicting accesses by the two threads, if any"""
+    accesses = [a for a in self.accesses \
+      if self.array is None or a.array == self.array]
+    first = [a for a in accesses if a.thread == 1]
+    second = [a for a in accesses if a.thread == 2]
+    for a in first:
+      for b in second:
+        if a.array == b.array and a.index == b.index and \
+           "write" in [a.kind, b.kind] and \
+           (different_groups or a.interval == b.interval):
+          return a, b
+    return None
+
+# Replaying
+
+_dimensions = ["x", "y", "z"]
+
+def _pad(values, default):
+  values = list(values or [])
+  return values + [default] * (3 - len(values))
+
+def _find_kernel(program, name):
+  kernels = [i for i in program["implementations"].values() \
+    if "kernel" in i.attributes]
+  for kernel in kernels:
+    source_name = kernel.attributes.get("source_name")
+    if name is not None and (kernel.name.lstrip("$") == name or \
+       (source_name and source_name[0][1].strip('"') == name)):
+      return kernel
+  if len(kernels) != 1:
+    raise ReplayError("cannot determine the kernel to replay")
+  return kernels[0]
+
+def _constants(program, thread, local_size, num_groups, global_offset):
+  values = {}
+  for index, dimension in enumerate(_dimensions):
+    values["local_id_" + dimension] = thread["local_id"][index]
+    values["group_id_" + dimension] = thread["group_id"][index]
+    values["group_size_" + dimension] = local_size[index]
+    values["num_groups_" + dimension] = num_groups[index]
+    values["global_offset_" + dimension] = global_offset[index]
+
+  constants = {}
+  for name, value in values.items():
+    width = 32
+    if name in program["constants"]:
+      width = _width(program["constants"][name].type)
+    constants[name] = value if width is None else _bv(value, width)
+  return constants
+
+def _memory(program, shared, same_group):
+  """The memory of thread: global and constant memory is shared by all threads
+  and group shared memory within a group; other memory is private"""
+  memory = {}
+  for name, variable in program["variables"].items():
+    if "global" in variable.attributes or "constant" in variable.attributes or \
+       ("group_shared" in variable.attributes and same_group):
+      memory[name] = shared.setdefault(name, _default(variable.type))
+    else:
+      memory[name] = _default(variable.type)
+  return memory
+
+def replay_race(program, error, local_size, num_groups, global_offset = None,
+                max_steps = 1000000):
+  """Replay the two threads reported in error, a race as returned by
+  parse_error_report, on program as parsed by parse_program. Memory not written
+  by the threads is read as zero, so if no race is found after reading such
+  memory, the replay is inconclusive"""
+  if error.get("kind") != "race" or len(error.get("accesses", [])) != 2 or \
+     any("thread" not in a or not isinstance(a["thread"].get("local_id"), \
+       list) for a in error["accesses"]):
+    return Replay("inconclusive", "the report does not identify two threads")
+
+  try:
+    kernel = _find_kernel(program, error.get("kernel"))
+    local_size = _pad(local_size, 1)
+    num_groups = _pad(num_groups, 1)
+    global_offset = _pad(global_offset, 0)
+    ids = [dict((k, _pad(a["thread"][k], 0)) for k in \
+      ["local_id", "group_id"]) for a in error["accesses"]]
+    same_group = ids[0]["group_id"] == ids[1]["group_id"]
+    if same_group and ids[0]["local_id"] == ids[1]["local_id"]:
+      return Replay("inconclusive", "the report names the same thread twice")
+
+    parameters = error.get("parameters", {})
+    arguments = []
+    for parameter in kernel.parameters:
+      name = parameter.name.lstrip("$")
+      if name not in parameters:
+        raise ReplayError("no value is reported for parameter '" + name + "'")
+      value = int(parameters[name]["value"], 0)
+      width = _width(parameter.type)
+      if width is None and parameter.type != "int":
+        raise ReplayError("parameter '" + name + "' has unsupported type " + \
+          str(parameter.type))
+      arguments.append(value if width is None else _bv(value, width))
+
+    interpreter = _Interpreter(program, error["race"]["array"], max_steps)
+    shared = {}
+    threads = []
+    for number, thread_ids in enumerate(ids, 1):
+      thread = _Thread(number, _constants(program, thread_ids, local_size,
+        num_groups, global_offset), _memory(program, shared, same_group))
+      interpreter.enter(thread, kernel, arguments)
+      if kernel.name in program["procedures"]:
+        interpreter.check_requires(thread, program["procedures"][kernel.name],
+          arguments)
+      threads.append(thread)
+
+    while True:
+      at_barrier = [interpreter.run(t) for t in threads]
+      if same_group and at_barrier[0] != at_barrier[1]:
+        return Replay("inconclusive", "only one of the threads reaches the " + \
+          "barrier in interval " + str(interpreter.interval))
+      if not any(at_barrier):
+        break
+      # Barriers only synchronise threads in the same group
+      if same_group:
+        interpreter.interval += 1
+  except ReplayError as e:
+    return Replay("inconclusive", str(e))
+
+  conflict = interpreter.conflict(not same_group)
+  if conflict is None and interpreter.unwritten:
+    return Replay("inconclusive", "the threads read memory they did not " + \
+      "write, of " + ", ".join(sorted(interpreter.unwritten)) + ", whose " + \
+      "values are not known")
+  if conflict is None:
+    return Replay("not reproduced", "the threads do not access the same " + \
+      "element of " + error["race"]["array"] + " with a write in the same " + \
+      "barrier interval")
+  first, second = conflict
+  return Replay("confirmed", "{} by thread 1 and {} by thread 2 of {}[{}]" \
+    .format(first.kind, second.kind, first.array, first.index) + \
+    ("" if not same_group else \
+     " in barrier interval " + str(first.interval)))
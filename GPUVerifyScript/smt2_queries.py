@@ -0,0 +1,120 @@
+"""Module for splitting the SMT-LIB logs written by --gen-smt2 into standalone
+queries, one per check-sat, and for storing them deduplicated by content."""
+
+import hashlib
+import json
+import os
+
+class Query(object):
+  """A standalone query: the commands in scope at a check-sat of a log. The
+  vc is the name Boogie gave the verification condition checked, if any"""
+  def __init__(self, commands, vc):
+    self.commands = commands
+    self.vc = vc
+
+  @property
+  def text(self):
+    return "\n".join(self.commands + ["(check-sat)", "(exit)"]) + "\n"
+
+  @property
+  def key(self):
+    return hashlib.sha1(self.text.encode("utf-8")).hexdigest()
+
+def __commands(text):
+  """Yield the top-level commands in text, an SMT-LIB script, without
+  comments"""
+  depth = 0
+  start = None
+  index = 0
+  while index < len(text):
+    char = text[index]
+    if char == ";":
+      newline = text.find("\n", index)
+      index = len(text) if newline < 0 else newline
+      continue
+    if char in "\"|":
+      close = text.find(char, index + 1)
+      # Doubled quotes escape a quote within a string
+      while char == "\"" and close >= 0 and text[close + 1:close + 2] == "\"":
+        close = text.find(char, close + 2)
+      index = len(text) if close < 0 else close + 1
+      continue
+    if char == "(":
+      if depth == 0:
+        start = index
+      depth += 1
+    elif char == ")":
+      depth -= 1
+      if depth == 0:
+        yield text[start:index + 1]
+    index += 1
+
+def __name(command):
+  return command[1:].split(None, 1)[0].rstrip(")") if len(command) > 2 else ""
+
+def split_log(text):
+  """Return the queries in text, an SMT-LIB log written by Boogie. Commands
+  that only inspect the result of a check-sat, such as get-value, are dropped,
+  as are the names Boogie gives its verification conditions, so that the same
+  query checked for different kernels or in different runs is identical"""
+  scopes = [[]]
+  vc = None
+  queries = []
+  for command in __commands(text):
+    name = __name(command)
+    if name == "push":
+      levels = command[1:-1].split()[1:]
+      for _ in range(int(levels[0]) if levels else 1):
+        scopes.append([])
+    elif name == "pop":
+      levels = command[1:-1].split()[1:]
+      for _ in range(int(levels[0]) if levels else 1):
+        if len(scopes) > 1:
+          scopes.pop()
+    elif name == "reset":
+      scopes = [[]]
+    elif name == "check-sat":
+      queries.append(Query(sum(scopes, []), vc))
+    elif name == "set-info" and ":boogie-vc-id" in command:
+      vc = command[1:-1].split(":boogie-vc-id", 1)[1].strip()
+    elif name in ["get-value", "get-model", "get-info", "get-unsat-core",
+                  "get-assignment", "get-proof", "echo", "labels", "exit"]:
+      continue
+    else:
+      scopes[-1].append(command)
+  return queries
+
+class QueryStore(object):
+  """A directory holding queries as <key>.smt2 files, with an index recording
+  where each query was seen"""
+  def __init__(self, directory):
+    self.directory = directory
+    self.index_file = os.path.join(directory, "index.json")
+    self.index = {}
+    if not os.path.isdir(directory):
+      os.makedirs(directory)
+    if os.path.isfile(self.index_file):
+      with open(self.index_file) as f:
+        self.index = json.load(f)
+
+  def path(self, key):
+    return os.path.join(self.directory, key + ".smt2")
+
+  def add(self, query, log, number):
+    """Add query, the number-th query of log. Returns whether the query was not
+    seen before"""
+    origin = { "log": os.path.abspath(log), "query": number, "vc": query.vc }
+    key = query.key
+    new = key not in self.index
+    if new:
+      with open(self.path(key), "w") as f:
+        f.write(query.text)
+      self.index[key] = []
+    if origin not in self.index[key]:
+      self.index[key].append(origin)
+    return new
+
+  def save(self):
+    with open(self.index_file, "w") as f:
+      json.dump(self.index, f, indent = 2, sort_keys = True)
+      f.write("\n")
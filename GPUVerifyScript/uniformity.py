@@ -0,0 +1,81 @@
+"""Module for summarising the results of the uniformity analysis that
+GPUVerifyVCGen prints with /showUniformityAnalysis. A variable that is uniform
+holds the same value in every thread, so GPUVerifyVCGen keeps a single copy of
+it for both threads; a branch on uniform variables needs no predication."""
+
+import re
+
+__procedure = re.compile(r"^Procedure\s+([^\s:]+)\s*:?\s*(\S*)\s*$")
+__variable = re.compile(r"^\s+([^\s:]+)\s*:\s*(\S+)\s*$")
+__values = { "true": True, "uniform": True, "false": False, "nonuniform": False,
+             "non-uniform": False }
+
+__implementation = re.compile(r"^implementation\s+(?:\{:[^}]*\}\s*)*" \
+  r"([\w.$#'~^?]+)")
+__partition = re.compile(r"^\s*assume\s+(?:\{:[^}]*\}\s*)*\{:partition\}\s*" \
+  r"(?:\{:[^}]*\}\s*)*(.*?)\s*;")
+__identifier = re.compile(r"[\w.$#'~^?]+")
+__thread_ids = re.compile(r"^(local|group)_id_[xyz]$")
+
+class Uniformity(object):
+  """The uniformity of the variables of a procedure, as a dictionary from the
+  names of the variables to whether they are uniform. The branches are the
+  guards of the branches in the procedure, mapped to whether they are
+  uniform"""
+  def __init__(self, procedure, uniform):
+    self.procedure = procedure
+    self.uniform = uniform
+    self.variables = {}
+    self.branches = {}
+
+  def uniform_variables(self):
+    return sorted(v for v, uniform in self.variables.items() if uniform)
+
+  def non_uniform_variables(self):
+    return sorted(v for v, uniform in self.variables.items() if not uniform)
+
+def parse_uniformity_analysis(output):
+  """Return the Uniformity of each procedure in output. Procedures whose
+  variables are not all described as uniform or not, such as those in the
+  results of other analyses, are left out"""
+  procedures = []
+  current = None
+  for line in output.splitlines():
+    matched = __procedure.match(line)
+    if matched:
+      current = Uniformity(matched.group(1),
+        __values.get(matched.group(2).lower()))
+      procedures.append(current)
+      continue
+    matched = __variable.match(line)
+    if matched and current is not None:
+      value = __values.get(matched.group(2).lower())
+      if value is None:
+        procedures.remove(current)
+        current = None
+      else:
+        current.variables[matched.group(1)] = value
+      continue
+    current = None
+  return [p for p in procedures if p.variables]
+
+def classify_branches(lines, procedures):
+  """Record in procedures, as returned by parse_uniformity_analysis, the
+  branches of the implementations in lines, the .gbpl file produced by Bugle.
+  A branch is uniform when its guard only refers to uniform variables"""
+  byName = dict((p.procedure, p) for p in procedures)
+  current = None
+  for line in lines:
+    matched = __implementation.match(line)
+    if matched:
+      current = byName.get(matched.group(1))
+      continue
+    matched = __partition.match(line)
+    if not matched or current is None:
+      continue
+    guard = matched.group(1)
+    # Each branch is guarded by a condition and its negation
+    if guard.startswith("!"):
+      continue
+    current.branches[guard] = all(current.variables.get(i, True) and \
+      not __thread_ids.match(i) for i in __identifier.findall(guard))
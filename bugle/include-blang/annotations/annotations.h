@@ -237,6 +237,14 @@ _DEVICE_QUALIFIER bool __other_bool(bool expr);
 #define __same_group (blockIdx.x == __other_int(blockIdx.x) \
                     & blockIdx.y == __other_int(blockIdx.y) \
                     & blockIdx.z == __other_int(blockIdx.z))
+
+/* Warps. Lanes are related between the two threads being considered rather
+   than enumerated, so these do not grow with the warp size */
+#define __linear_tid (threadIdx.x + blockDim.x * \
+                      (threadIdx.y + blockDim.y * threadIdx.z))
+#define __lane_id (__linear_tid & (__WARP_SIZE - 1))
+#define __warp_id (__linear_tid / __WARP_SIZE)
+#define __same_warp (__same_group & (__warp_id == __other_int(__warp_id)))
 #endif
 
 /* Axioms */
@@ -0,0 +1,38 @@
+#ifndef BUGLE_ATOMICS_H
+#define BUGLE_ATOMICS_H
+
+#include <device_qualifier.h>
+
+/* Generic atomic declaration, parameterised by operation, address space and
+   type. INTRINSIC is the function bugle translates into an access of the
+   atomic array, so its name must encode the operation and type; NAME is the
+   overload exposed to kernels, which forwards to it. ARITY is the number of
+   parameters, including the pointer. Every intrinsic shares the same
+   race-exemption model in GPUVerifyVCGen */
+
+#define __BUGLE_ATOMIC_PARAMS_1(SPACE, TYPE) (volatile SPACE TYPE * x)
+#define __BUGLE_ATOMIC_PARAMS_2(SPACE, TYPE) (volatile SPACE TYPE * x, TYPE y)
+#define __BUGLE_ATOMIC_PARAMS_3(SPACE, TYPE) \
+    (volatile SPACE TYPE * x, TYPE y, TYPE z)
+
+#define __BUGLE_ATOMIC_ARGS_1 (x)
+#define __BUGLE_ATOMIC_ARGS_2 (x, y)
+#define __BUGLE_ATOMIC_ARGS_3 (x, y, z)
+
+#define __BUGLE_ATOMIC(QUALIFIERS, NAME, INTRINSIC, ARITY, SPACE, TYPE) \
+    _DEVICE_QUALIFIER TYPE INTRINSIC __BUGLE_ATOMIC_PARAMS_##ARITY(SPACE, TYPE); \
+    QUALIFIERS TYPE NAME __BUGLE_ATOMIC_PARAMS_##ARITY(SPACE, TYPE) { \
+      return INTRINSIC __BUGLE_ATOMIC_ARGS_##ARITY; \
+    }
+
+/* Monotonic counters. When __BUGLE_ATOMIC_COUNTERS is defined, an atomic add
+   of the constant 1 is treated as an atomic increment, so that counters that
+   are only ever incremented get the refined counter abstraction (see
+   __atomic_has_taken_value) instead of an unconstrained result */
+
+#ifdef __BUGLE_ATOMIC_COUNTERS
+#define __BUGLE_ATOMIC_ADD_OR_INC(y, ADD, INC) \
+    (__builtin_constant_p(y) && (y) == 1 ? (INC) : (ADD))
+#endif
+
+#endif
@@ -20,4 +20,4 @@ __CLC_DECLARE_ATOMIC_ADDRSPACE_3_ARG(__CLC_FUNCTION, uint)
 
 #undef __CLC_FUNCTION
 #undef __CLC_DECLARE_ATOMIC_3_ARG
-#undef __CLC_DECLARE_ATOMIC_ADDRESS_SPACE_3_ARG
+#undef __CLC_DECLARE_ATOMIC_ADDRSPACE_3_ARG
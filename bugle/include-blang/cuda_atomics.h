@@ -1,15 +1,18 @@
 #ifndef CUDA_ATOMICS_H
 #define CUDA_ATOMICS_H
 
+#include <bugle_atomics.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define ATOMIC_INT_DECL(OP) \
-    __device__ int __atomic##OP##_int(volatile int * x, int y); \
-    __device__ static __attribute__((always_inline)) __attribute__((overloadable)) int atomic##OP(volatile int * x, int y) { \
-      return __atomic##OP##_int(x,y); \
-    }
+#define ATOMIC_DECL(OP, TYPE_NAME, TYPE, ARITY) \
+    __BUGLE_ATOMIC(__device__ static __attribute__((always_inline)) \
+      __attribute__((overloadable)), atomic##OP, __atomic##OP##_##TYPE_NAME, \
+      ARITY, , TYPE)
+
+#define ATOMIC_INT_DECL(OP) ATOMIC_DECL(OP, int, int, 2)
 
 ATOMIC_INT_DECL(Add)
 ATOMIC_INT_DECL(Sub)
@@ -22,10 +25,7 @@ ATOMIC_INT_DECL(Xor)
 
 #undef ATOMIC_INT_DECL
 #define ATOMIC_UNSIGNED_INT_DECL(OP) \
-    __device__ unsigned int __atomic##OP##_unsigned_int(volatile unsigned int * x, unsigned int y); \
-    __device__ static __attribute__((always_inline)) __attribute__((overloadable)) unsigned int atomic##OP(volatile unsigned int * x, unsigned int y) { \
-      return __atomic##OP##_unsigned_int(x,y); \
-    }
+    ATOMIC_DECL(OP, unsigned_int, unsigned int, 2)
 
 ATOMIC_UNSIGNED_INT_DECL(Add)
 ATOMIC_UNSIGNED_INT_DECL(Sub)
@@ -41,10 +41,7 @@ ATOMIC_UNSIGNED_INT_DECL(Dec)
 #undef ATOMIC_UNSIGNED_INT_DECL
 
 #define ATOMIC_UNSIGNED_LONG_LONG_INT_DECL(OP) \
-    __device__ unsigned long long int __atomic##OP##_unsigned_long_long_int(volatile unsigned long long int * x, unsigned long long int y); \
-    __device__ static __attribute__((always_inline)) __attribute__((overloadable)) unsigned long long int atomic##OP(volatile unsigned long long int * x, unsigned long long int y) { \
-      return __atomic##OP##_unsigned_long_long_int(x,y); \
-    }
+    ATOMIC_DECL(OP, unsigned_long_long_int, unsigned long long int, 2)
 
 ATOMIC_UNSIGNED_LONG_LONG_INT_DECL(Add)
 ATOMIC_UNSIGNED_LONG_LONG_INT_DECL(Exch)
@@ -56,11 +53,7 @@ ATOMIC_UNSIGNED_LONG_LONG_INT_DECL(Xor)
 
 #undef ATOMIC_UNSIGNED_LONG_LONG_INT_DECL
 
-#define ATOMIC_FLOAT_DECL(OP) \
-    __device__ float __atomic##OP##_float(volatile float * x, float y); \
-    __device__ static __attribute__((always_inline)) __attribute__((overloadable)) float atomic##OP(volatile float * x, float y) { \
-      return __atomic##OP##_float(x,y); \
-    }
+#define ATOMIC_FLOAT_DECL(OP) ATOMIC_DECL(OP, float, float, 2)
 
 ATOMIC_FLOAT_DECL(Add)
 ATOMIC_FLOAT_DECL(Exch)
@@ -68,18 +61,29 @@ ATOMIC_FLOAT_DECL(Exch)
 #undef ATOMIC_FLOAT_DECL
 
 /* atomicCAS(x, y, z) */
-__device__ int __atomicCAS_int(volatile int * x, int y, int z); \
-__device__ static __attribute__((always_inline)) __attribute__((overloadable)) int atomicCAS(volatile int * x, int y, int z) {
-  return __atomicCAS_int(x,y,z);
+ATOMIC_DECL(CAS, int, int, 3)
+ATOMIC_DECL(CAS, unsigned_int, unsigned int, 3)
+ATOMIC_DECL(CAS, unsigned_long_long_int, unsigned long long int, 3)
+
+#undef ATOMIC_DECL
+
+/* An unsigned atomicAdd of 1 is an atomicInc that never wraps around */
+#ifdef __BUGLE_ATOMIC_COUNTERS
+__device__ static __attribute__((always_inline)) __attribute__((overloadable)) unsigned int __atomicAddOne(volatile unsigned int * x) {
+  return atomicInc(x, 0xffffffffu);
+}
+__device__ static __attribute__((always_inline)) __attribute__((overloadable)) int __atomicAddOne(volatile int * x) {
+  return atomicAdd(x, 1);
 }
-__device__ unsigned int __atomicCAS_unsigned_int(volatile unsigned int * x, unsigned int y, unsigned int z); \
-__device__ static __attribute__((always_inline)) __attribute__((overloadable)) unsigned int atomicCAS(volatile unsigned int * x, unsigned int y, unsigned int z) {
-  return __atomicCAS_unsigned_int(x,y,z);
+__device__ static __attribute__((always_inline)) __attribute__((overloadable)) unsigned long long int __atomicAddOne(volatile unsigned long long int * x) {
+  return atomicAdd(x, 1ull);
 }
-__device__ unsigned long long int __atomicCAS_unsigned_long_long_int(volatile unsigned long long int * x, unsigned long long int y, unsigned long long int z); \
-__device__ static __attribute__((always_inline)) __attribute__((overloadable)) unsigned long long int atomicCAS(volatile unsigned long long int * x, unsigned long long int y, unsigned long long int z) {
-  return __atomicCAS_unsigned_long_long_int(x,y,z);
+__device__ static __attribute__((always_inline)) __attribute__((overloadable)) float __atomicAddOne(volatile float * x) {
+  return atomicAdd(x, 1.0f);
 }
+#define atomicAdd(x, y) \
+    __BUGLE_ATOMIC_ADD_OR_INC(y, atomicAdd(x, y), __atomicAddOne(x))
+#endif
 
 
 /*
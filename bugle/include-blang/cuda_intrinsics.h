@@ -5,14 +5,108 @@ extern "C" __device__ int printf(const char *format, ...);
 
 #if __CUDA_ARCH__ >= 300
 
-__device__ int __shfl(int var, int srcLane, int width=warpSize);
-__device__ int __shfl_up(int var, unsigned int delta, int width=warpSize);
-__device__ int __shfl_down(int var, unsigned int delta, int width=warpSize);
-__device__ int __shfl_xor(int var, int laneMask, int width=warpSize);
-__device__ float __shfl(float var, int srcLane, int width=warpSize);
-__device__ float __shfl_up(float var, unsigned int delta, int width=warpSize);
-__device__ float __shfl_down(float var, unsigned int delta, int width=warpSize);
-__device__ float __shfl_xor(float var, int laneMask, int width=warpSize);
+/* Shuffles. The value obtained by a thread is related to the value of var held
+   by the other thread being considered when that thread is the source lane, so
+   shuffles are modelled without enumerating the lanes of a warp. Two threads
+   of a warp that read from the same lane obtain the same value. Nothing is
+   assumed about a source lane that is not active, whose value is undefined */
+
+__device__ int __bugle_shfl_int(void);
+
+_BUGLE_INLINE __device__ int __shfl_from_lane(int var, int srcLane) {
+  int result = __bugle_shfl_int();
+  __assume(__implies(srcLane == __lane_id, result == var));
+  __assume(__implies(__same_warp & __other_bool(__enabled()) &
+                     srcLane == __other_int(__lane_id),
+                     result == __other_int(var)));
+  __assume(__implies(__same_warp & __other_bool(__enabled()) &
+                     srcLane == __other_int(srcLane),
+                     result == __other_int(result)));
+  return result;
+}
+
+/* A float is shuffled as its bits. The bit-casts go through a union, which
+   Bugle translates exactly; __float_as_int and __int_as_float are only
+   declared, so each of their calls would yield an arbitrary value */
+
+_BUGLE_INLINE __device__ int __bugle_float_bits(float x) {
+  union { float f; int i; } bits;
+  bits.f = x;
+  return bits.i;
+}
+
+_BUGLE_INLINE __device__ float __bugle_bits_float(int x) {
+  union { int i; float f; } bits;
+  bits.i = x;
+  return bits.f;
+}
+
+_BUGLE_INLINE __device__ float __shfl_from_lane(float var, int srcLane) {
+  return __bugle_bits_float(__shfl_from_lane(__bugle_float_bits(var),
+                                             srcLane));
+}
+
+/* Source lanes. A warp is split into segments of width lanes; a thread that
+   would read from outside its segment obtains its own value, except that
+   __shfl wraps around within the segment */
+
+_BUGLE_INLINE __device__ int __shfl_lane(int srcLane, int width) {
+  return (__lane_id & ~(width - 1)) | (srcLane & (width - 1));
+}
+
+_BUGLE_INLINE __device__ int __shfl_up_lane(unsigned int delta, int width) {
+  return (__lane_id & (width - 1)) < delta ? __lane_id : __lane_id - delta;
+}
+
+_BUGLE_INLINE __device__ int __shfl_down_lane(unsigned int delta, int width) {
+  return (__lane_id & (width - 1)) + delta >= width ? __lane_id
+                                                    : __lane_id + delta;
+}
+
+_BUGLE_INLINE __device__ int __shfl_xor_lane(int laneMask, int width) {
+  int srcLane = __lane_id ^ laneMask;
+  return (srcLane & ~(width - 1)) > (__lane_id & ~(width - 1)) ? __lane_id
+                                                               : srcLane;
+}
+
+_BUGLE_INLINE __device__ int __shfl(int var, int srcLane, int width=warpSize) {
+  return __shfl_from_lane(var, __shfl_lane(srcLane, width));
+}
+
+_BUGLE_INLINE __device__ int __shfl_up(int var, unsigned int delta,
+                                       int width=warpSize) {
+  return __shfl_from_lane(var, __shfl_up_lane(delta, width));
+}
+
+_BUGLE_INLINE __device__ int __shfl_down(int var, unsigned int delta,
+                                         int width=warpSize) {
+  return __shfl_from_lane(var, __shfl_down_lane(delta, width));
+}
+
+_BUGLE_INLINE __device__ int __shfl_xor(int var, int laneMask,
+                                        int width=warpSize) {
+  return __shfl_from_lane(var, __shfl_xor_lane(laneMask, width));
+}
+
+_BUGLE_INLINE __device__ float __shfl(float var, int srcLane,
+                                      int width=warpSize) {
+  return __shfl_from_lane(var, __shfl_lane(srcLane, width));
+}
+
+_BUGLE_INLINE __device__ float __shfl_up(float var, unsigned int delta,
+                                         int width=warpSize) {
+  return __shfl_from_lane(var, __shfl_up_lane(delta, width));
+}
+
+_BUGLE_INLINE __device__ float __shfl_down(float var, unsigned int delta,
+                                           int width=warpSize) {
+  return __shfl_from_lane(var, __shfl_down_lane(delta, width));
+}
+
+_BUGLE_INLINE __device__ float __shfl_xor(float var, int laneMask,
+                                          int width=warpSize) {
+  return __shfl_from_lane(var, __shfl_xor_lane(laneMask, width));
+}
 
 #endif
 
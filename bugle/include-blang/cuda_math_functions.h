@@ -357,6 +357,7 @@ __device__ unsigned long long int ullmin(unsigned long long int x, unsigned long
 
 __device__ int __float2int_rn(float x);
 __device__ float __int_as_float(int x);
+__device__ int __float_as_int(float x);
 
 #ifdef __cplusplus
 }
@@ -31,471 +31,526 @@ typedef unsigned long long cudaTextureObject_t;
 template<class T, int texType = cudaTextureType1D, enum cudaTextureReadMode mode = cudaReadModeElementType>
 struct texture { T a; int b; enum cudaTextureReadMode c; };
 
-/* texture_fetch_instructions.h */
-
-template <class T>
-__device__ T tex1Dfetch(texture<T, cudaTextureType1D, cudaReadModeElementType> t, int x);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex1Dfetch(texture<TYPE, cudaTextureType1D, cudaReadModeNormalizedFloat> t, int x); \
-  __device__ float tex1Dfetch(texture<unsigned TYPE, cudaTextureType1D, cudaReadModeNormalizedFloat> t, int x); \
-  __device__ float1 tex1Dfetch(texture<TYPE##1, cudaTextureType1D, cudaReadModeNormalizedFloat> t, int x); \
-  __device__ float1 tex1Dfetch(texture<u##TYPE##1, cudaTextureType1D, cudaReadModeNormalizedFloat> t, int x); \
-  __device__ float2 tex1Dfetch(texture<TYPE##2, cudaTextureType1D, cudaReadModeNormalizedFloat> t, int x); \
-  __device__ float2 tex1Dfetch(texture<u##TYPE##2, cudaTextureType1D, cudaReadModeNormalizedFloat> t, int x); \
-  __device__ float4 tex1Dfetch(texture<TYPE##4, cudaTextureType1D, cudaReadModeNormalizedFloat> t, int x); \
-  __device__ float4 tex1Dfetch(texture<u##TYPE##4, cudaTextureType1D, cudaReadModeNormalizedFloat> t, int x);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex1D(texture<T, cudaTextureType1D, cudaReadModeElementType> t, float x);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex1D(texture<TYPE, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x); \
-  __device__ float tex1D(texture<unsigned TYPE, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x); \
-  __device__ float1 tex1D(texture<TYPE##1, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x); \
-  __device__ float1 tex1D(texture<u##TYPE##1, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x); \
-  __device__ float2 tex1D(texture<TYPE##2, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x); \
-  __device__ float2 tex1D(texture<u##TYPE##2, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x); \
-  __device__ float4 tex1D(texture<TYPE##4, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x); \
-  __device__ float4 tex1D(texture<u##TYPE##4, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex2D(texture<T, cudaTextureType2D, cudaReadModeElementType> t, float x, float y);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex2D(texture<TYPE, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y); \
-  __device__ float tex2D(texture<unsigned TYPE, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y); \
-  __device__ float1 tex2D(texture<TYPE##1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y); \
-  __device__ float1 tex2D(texture<u##TYPE##1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y); \
-  __device__ float2 tex2D(texture<TYPE##2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y); \
-  __device__ float2 tex2D(texture<u##TYPE##2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y); \
-  __device__ float4 tex2D(texture<TYPE##4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y); \
-  __device__ float4 tex2D(texture<u##TYPE##4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex1DLayered(texture<T, cudaTextureType1DLayered, cudaReadModeElementType> t, float x, int layer);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex1DLayered(texture<TYPE, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer); \
-  __device__ float tex1DLayered(texture<unsigned TYPE, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer); \
-  __device__ float1 tex1DLayered(texture<TYPE##1, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer); \
-  __device__ float1 tex1DLayered(texture<u##TYPE##1, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer); \
-  __device__ float2 tex1DLayered(texture<TYPE##2, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer); \
-  __device__ float2 tex1DLayered(texture<u##TYPE##2, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer); \
-  __device__ float4 tex1DLayered(texture<TYPE##4, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer); \
-  __device__ float4 tex1DLayered(texture<u##TYPE##4, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex2DLayered(texture<T, cudaTextureType2DLayered, cudaReadModeElementType> t, float x, float y, int layer);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex2DLayered(texture<TYPE, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer); \
-  __device__ float tex2DLayered(texture<unsigned TYPE, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer); \
-  __device__ float1 tex2DLayered(texture<TYPE##1, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer); \
-  __device__ float1 tex2DLayered(texture<u##TYPE##1, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer); \
-  __device__ float2 tex2DLayered(texture<TYPE##2, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer); \
-  __device__ float2 tex2DLayered(texture<u##TYPE##2, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer); \
-  __device__ float4 tex2DLayered(texture<TYPE##4, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer); \
-  __device__ float4 tex2DLayered(texture<u##TYPE##4, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex3D(texture<T, cudaTextureType3D, cudaReadModeElementType> t, float x, float y, float z);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex3D(texture<TYPE, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float tex3D(texture<unsigned TYPE, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float1 tex3D(texture<TYPE##1, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float1 tex3D(texture<u##TYPE##1, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float2 tex3D(texture<TYPE##2, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float2 tex3D(texture<u##TYPE##2, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float4 tex3D(texture<TYPE##4, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float4 tex3D(texture<u##TYPE##4, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T texCubemap(texture<T, cudaTextureTypeCubemap, cudaReadModeElementType> t, float x, float y, float z);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float texCubemap(texture<TYPE, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float texCubemap(texture<unsigned TYPE, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float1 texCubemap(texture<TYPE##1, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float1 texCubemap(texture<u##TYPE##1, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float2 texCubemap(texture<TYPE##2, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float2 texCubemap(texture<u##TYPE##2, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float4 texCubemap(texture<TYPE##4, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z); \
-  __device__ float4 texCubemap(texture<u##TYPE##4, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T texCubemapLayered(texture<T, cudaTextureTypeCubemapLayered, cudaReadModeElementType> t, float x, float y, float z, int layer);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float texCubemapLayered(texture<TYPE, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer); \
-  __device__ float texCubemapLayered(texture<unsigned TYPE, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer); \
-  __device__ float1 texCubemapLayered(texture<TYPE##1, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer); \
-  __device__ float1 texCubemapLayered(texture<u##TYPE##1, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer); \
-  __device__ float2 texCubemapLayered(texture<TYPE##2, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer); \
-  __device__ float2 texCubemapLayered(texture<u##TYPE##2, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer); \
-  __device__ float4 texCubemapLayered(texture<TYPE##4, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer); \
-  __device__ float4 texCubemapLayered(texture<u##TYPE##4, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-__device__ char4 tex2Dgather(texture<char, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ char4 tex2Dgather(texture<signed char, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uchar4 tex2Dgather(texture<unsigned char, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ char4 tex2Dgather(texture<char1, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uchar4 tex2Dgather(texture<uchar1, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ char4 tex2Dgather(texture<char2, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uchar4 tex2Dgather(texture<uchar2, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ char4 tex2Dgather(texture<char3, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uchar4 tex2Dgather(texture<uchar3, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ char4 tex2Dgather(texture<char4, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uchar4 tex2Dgather(texture<uchar4, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ short4 tex2Dgather(texture<signed short, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ ushort4 tex2Dgather(texture<unsigned short, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ short4 tex2Dgather(texture<short1, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ ushort4 tex2Dgather(texture<ushort1, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ short4 tex2Dgather(texture<short2, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ ushort4 tex2Dgather(texture<ushort2, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ short4 tex2Dgather(texture<short3, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ ushort4 tex2Dgather(texture<ushort3, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ short4 tex2Dgather(texture<short4, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ ushort4 tex2Dgather(texture<ushort4, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ int4 tex2Dgather(texture<signed int, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uint4 tex2Dgather(texture<unsigned int, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ int4 tex2Dgather(texture<int1, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uint4 tex2Dgather(texture<uint1, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ int4 tex2Dgather(texture<int2, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uint4 tex2Dgather(texture<uint2, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ int4 tex2Dgather(texture<int3, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uint4 tex2Dgather(texture<uint3, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ int4 tex2Dgather(texture<int4, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ uint4 tex2Dgather(texture<uint4, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<float, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<float1, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<float2, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<float3, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<float4, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<char, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<signed char, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<unsigned char, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<char1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<uchar1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<char2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<uchar2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<char3, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<uchar3, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<char4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<uchar4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<signed short, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<unsigned short, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<short1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<ushort1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<short2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<ushort2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<short3, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<ushort3, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<short4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-__device__ float4 tex2Dgather(texture<ushort4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, int comp = 0);
-
-template <class T>
-__device__ T tex1DLod(texture<T, cudaTextureType1D, cudaReadModeElementType> t, float x, float level);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex1DLod(texture<TYPE, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float level); \
-  __device__ float tex1DLod(texture<unsigned TYPE, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float level); \
-  __device__ float1 tex1DLod(texture<TYPE##1, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float level); \
-  __device__ float1 tex1DLod(texture<u##TYPE##1, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float level); \
-  __device__ float2 tex1DLod(texture<TYPE##2, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float level); \
-  __device__ float2 tex1DLod(texture<u##TYPE##2, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float level); \
-  __device__ float4 tex1DLod(texture<TYPE##4, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float level); \
-  __device__ float4 tex1DLod(texture<u##TYPE##4, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float level);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex2DLod(texture<T, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, float level);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex2DLod(texture<TYPE, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float level); \
-  __device__ float tex2DLod(texture<unsigned TYPE, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float level); \
-  __device__ float1 tex2DLod(texture<TYPE##1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float level); \
-  __device__ float1 tex2DLod(texture<u##TYPE##1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float level); \
-  __device__ float2 tex2DLod(texture<TYPE##2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float level); \
-  __device__ float2 tex2DLod(texture<u##TYPE##2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float level); \
-  __device__ float4 tex2DLod(texture<TYPE##4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float level); \
-  __device__ float4 tex2DLod(texture<u##TYPE##4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float level);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex1DLayeredLod(texture<T, cudaTextureType1DLayered, cudaReadModeElementType> t, float x, int layer, float level);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex1DLayeredLod(texture<TYPE, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float level); \
-  __device__ float tex1DLayeredLod(texture<unsigned TYPE, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float level); \
-  __device__ float1 tex1DLayeredLod(texture<TYPE##1, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float level); \
-  __device__ float1 tex1DLayeredLod(texture<u##TYPE##1, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float level); \
-  __device__ float2 tex1DLayeredLod(texture<TYPE##2, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float level); \
-  __device__ float2 tex1DLayeredLod(texture<u##TYPE##2, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float level); \
-  __device__ float4 tex1DLayeredLod(texture<TYPE##4, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float level); \
-  __device__ float4 tex1DLayeredLod(texture<u##TYPE##4, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float level);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex2DLayeredLod(texture<T, cudaTextureType2DLayered, cudaReadModeElementType> t, float x, float y, int layer, float level);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex2DLayeredLod(texture<TYPE, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float level); \
-  __device__ float tex2DLayeredLod(texture<unsigned TYPE, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float level); \
-  __device__ float1 tex2DLayeredLod(texture<TYPE##1, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float level); \
-  __device__ float1 tex2DLayeredLod(texture<u##TYPE##1, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float level); \
-  __device__ float2 tex2DLayeredLod(texture<TYPE##2, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float level); \
-  __device__ float2 tex2DLayeredLod(texture<u##TYPE##2, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float level); \
-  __device__ float4 tex2DLayeredLod(texture<TYPE##4, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float level); \
-  __device__ float4 tex2DLayeredLod(texture<u##TYPE##4, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float level);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex3DLod(texture<T, cudaTextureType3D, cudaReadModeElementType> t, float x, float y, float z, float level);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex3DLod(texture<TYPE, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float tex3DLod(texture<unsigned TYPE, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float1 tex3DLod(texture<TYPE##1, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float1 tex3DLod(texture<u##TYPE##1, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float2 tex3DLod(texture<TYPE##2, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float2 tex3DLod(texture<u##TYPE##2, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float4 tex3DLod(texture<TYPE##4, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float4 tex3DLod(texture<u##TYPE##4, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T texCubemapLod(texture<T, cudaTextureTypeCubemap, cudaReadModeElementType> t, float x, float y, float z, float level);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float texCubemapLod(texture<TYPE, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float texCubemapLod(texture<unsigned TYPE, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float1 texCubemapLod(texture<TYPE##1, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float1 texCubemapLod(texture<u##TYPE##1, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float2 texCubemapLod(texture<TYPE##2, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float2 texCubemapLod(texture<u##TYPE##2, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float4 texCubemapLod(texture<TYPE##4, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level); \
-  __device__ float4 texCubemapLod(texture<u##TYPE##4, cudaTextureTypeCubemap, cudaReadModeNormalizedFloat> t, float x, float y, float z, float level);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T texCubemapLayeredLod(texture<T, cudaTextureTypeCubemapLayered, cudaReadModeElementType> t, float x, float y, float z, int layer, float level);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float texCubemapLayeredLod(texture<TYPE, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer, float level); \
-  __device__ float texCubemapLayeredLod(texture<unsigned TYPE, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer, float level); \
-  __device__ float1 texCubemapLayeredLod(texture<TYPE##1, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer, float level); \
-  __device__ float1 texCubemapLayeredLod(texture<u##TYPE##1, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer, float level); \
-  __device__ float2 texCubemapLayeredLod(texture<TYPE##2, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer, float level); \
-  __device__ float2 texCubemapLayeredLod(texture<u##TYPE##2, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer, float level); \
-  __device__ float4 texCubemapLayeredLod(texture<TYPE##4, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer, float level); \
-  __device__ float4 texCubemapLayeredLod(texture<u##TYPE##4, cudaTextureTypeCubemapLayered, cudaReadModeNormalizedFloat> t, float x, float y, float z, int layer, float level);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex1DGrad(texture<T, cudaTextureType1D, cudaReadModeElementType> t, float x, float dPdx, float dPdy);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex1DGrad(texture<TYPE, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float dPdx, float dPdy); \
-  __device__ float tex1DGrad(texture<unsigned TYPE, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float dPdx, float dPdy); \
-  __device__ float1 tex1DGrad(texture<TYPE##1, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float dPdx, float dPdy); \
-  __device__ float1 tex1DGrad(texture<u##TYPE##1, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float dPdx, float dPdy); \
-  __device__ float2 tex1DGrad(texture<TYPE##2, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float dPdx, float dPdy); \
-  __device__ float2 tex1DGrad(texture<u##TYPE##2, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float dPdx, float dPdy); \
-  __device__ float4 tex1DGrad(texture<TYPE##4, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float dPdx, float dPdy); \
-  __device__ float4 tex1DGrad(texture<u##TYPE##4, cudaTextureType1D, cudaReadModeNormalizedFloat> t, float x, float dPdx, float dPdy);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex2DGrad(texture<T, cudaTextureType2D, cudaReadModeElementType> t, float x, float y, float2 dPdx, float2 dPdy);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex2DGrad(texture<TYPE, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float2 dPdx, float2 dPdy); \
-  __device__ float tex2DGrad(texture<unsigned TYPE, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float2 dPdx, float2 dPdy); \
-  __device__ float1 tex2DGrad(texture<TYPE##1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float2 dPdx, float2 dPdy); \
-  __device__ float1 tex2DGrad(texture<u##TYPE##1, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float2 dPdx, float2 dPdy); \
-  __device__ float2 tex2DGrad(texture<TYPE##2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float2 dPdx, float2 dPdy); \
-  __device__ float2 tex2DGrad(texture<u##TYPE##2, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float2 dPdx, float2 dPdy); \
-  __device__ float4 tex2DGrad(texture<TYPE##4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float2 dPdx, float2 dPdy); \
-  __device__ float4 tex2DGrad(texture<u##TYPE##4, cudaTextureType2D, cudaReadModeNormalizedFloat> t, float x, float y, float2 dPdx, float2 dPdy);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex1DLayeredGrad(texture<T, cudaTextureType1DLayered, cudaReadModeElementType> t, float x, int layer, float dPdx, float dPdy);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex1DLayeredGrad(texture<TYPE, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float dPdx, float dPdy); \
-  __device__ float tex1DLayeredGrad(texture<unsigned TYPE, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float dPdx, float dPdy); \
-  __device__ float1 tex1DLayeredGrad(texture<TYPE##1, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float dPdx, float dPdy); \
-  __device__ float1 tex1DLayeredGrad(texture<u##TYPE##1, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float dPdx, float dPdy); \
-  __device__ float2 tex1DLayeredGrad(texture<TYPE##2, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float dPdx, float dPdy); \
-  __device__ float2 tex1DLayeredGrad(texture<u##TYPE##2, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float dPdx, float dPdy); \
-  __device__ float4 tex1DLayeredGrad(texture<TYPE##4, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float dPdx, float dPdy); \
-  __device__ float4 tex1DLayeredGrad(texture<u##TYPE##4, cudaTextureType1DLayered, cudaReadModeNormalizedFloat> t, float x, int layer, float dPdx, float dPdy);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex2DLayeredGrad(texture<T, cudaTextureType2DLayered, cudaReadModeElementType> t, float x, float y, int layer, float2 dPdx, float2 dPdy);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex2DLayeredGrad(texture<TYPE, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float2 dPdx, float2 dPdy); \
-  __device__ float tex2DLayeredGrad(texture<unsigned TYPE, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float2 dPdx, float2 dPdy); \
-  __device__ float1 tex2DLayeredGrad(texture<TYPE##1, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float2 dPdx, float2 dPdy); \
-  __device__ float1 tex2DLayeredGrad(texture<u##TYPE##1, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float2 dPdx, float2 dPdy); \
-  __device__ float2 tex2DLayeredGrad(texture<TYPE##2, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float2 dPdx, float2 dPdy); \
-  __device__ float2 tex2DLayeredGrad(texture<u##TYPE##2, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float2 dPdx, float2 dPdy); \
-  __device__ float4 tex2DLayeredGrad(texture<TYPE##4, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float2 dPdx, float2 dPdy); \
-  __device__ float4 tex2DLayeredGrad(texture<u##TYPE##4, cudaTextureType2DLayered, cudaReadModeNormalizedFloat> t, float x, float y, int layer, float2 dPdx, float2 dPdy);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
-
-template <class T>
-__device__ T tex3DGrad(texture<T, cudaTextureType3D, cudaReadModeElementType> t, float x, float y, float z, float4 dPdx, float4 dPdy);
-#define MK_GETFLOAT(TYPE) \
-  __device__ float tex3DGrad(texture<TYPE, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float4 dPdx, float4 dPdy); \
-  __device__ float tex3DGrad(texture<unsigned TYPE, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float4 dPdx, float4 dPdy); \
-  __device__ float1 tex3DGrad(texture<TYPE##1, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float4 dPdx, float4 dPdy); \
-  __device__ float1 tex3DGrad(texture<u##TYPE##1, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float4 dPdx, float4 dPdy); \
-  __device__ float2 tex3DGrad(texture<TYPE##2, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float4 dPdx, float4 dPdy); \
-  __device__ float2 tex3DGrad(texture<u##TYPE##2, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float4 dPdx, float4 dPdy); \
-  __device__ float4 tex3DGrad(texture<TYPE##4, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float4 dPdx, float4 dPdy); \
-  __device__ float4 tex3DGrad(texture<u##TYPE##4, cudaTextureType3D, cudaReadModeNormalizedFloat> t, float x, float y, float z, float4 dPdx, float4 dPdy);
-MK_GETFLOAT(char)
-MK_GETFLOAT(short)
-#undef MK_GETFLOAT
+/* Texture reads
+   =============
+
+   Texture memory cannot be written by a kernel, so a texture read is a pure
+   function of the texture and of the coordinates at which it is sampled.
+   Rather than declaring a separate procedure for every entry point, texel
+   type and read mode, all reads are routed through __bugle_texel<T>::read,
+   which bottoms out in uninterpreted functions per component type.  Two
+   reads of the same texture at the same coordinates hence agree (also
+   between the two threads), and as no memory is accessed no race
+   instrumentation is generated for texture reads.
+
+   A texture reference is identified by its address, which is distinct for
+   each texture and, unlike the fields of the reference, is not loaded from
+   memory.  A texture object is identified by its handle.  References and
+   objects are read through separate functions, so that a reference and an
+   object never alias.  Reads with gradients and gathers are not modelled
+   precisely and yield arbitrary values.
+*/
+
+#define __BUGLE_TEXTURE_FETCH 0
+#define __BUGLE_TEXTURE_SAMPLE 1
+#define __BUGLE_TEXTURE_LOD 2
+
+#define __BUGLE_TEXTURE_PARAMS \
+  int kind, int i, float x, float y, float z, int layer, float level
+#define __BUGLE_TEXTURE_ARGS kind, i, x, y, z, layer, level
+
+template <class T> struct __bugle_texture_component;
+
+#define __BUGLE_TEXTURE_COMPONENT(TYPE, NAME) \
+  extern "C" __device__ TYPE \
+  __uninterpreted_function___bugle_texture_object_read_##NAME( \
+    cudaTextureObject_t tex, __BUGLE_TEXTURE_PARAMS, int component); \
+  extern "C" __device__ TYPE \
+  __uninterpreted_function___bugle_texture_reference_read_##NAME( \
+    const void *tex, __BUGLE_TEXTURE_PARAMS, int component); \
+  template <> struct __bugle_texture_component<TYPE> { \
+    __device__ static __inline__ TYPE read(cudaTextureObject_t tex, \
+      __BUGLE_TEXTURE_PARAMS, int component) { \
+      return __uninterpreted_function___bugle_texture_object_read_##NAME( \
+        tex, __BUGLE_TEXTURE_ARGS, component); \
+    } \
+    __device__ static __inline__ TYPE read(const void *tex, \
+      __BUGLE_TEXTURE_PARAMS, int component) { \
+      return __uninterpreted_function___bugle_texture_reference_read_##NAME( \
+        tex, __BUGLE_TEXTURE_ARGS, component); \
+    } \
+  };
+
+__BUGLE_TEXTURE_COMPONENT(signed char, char)
+__BUGLE_TEXTURE_COMPONENT(unsigned char, uchar)
+__BUGLE_TEXTURE_COMPONENT(short, short)
+__BUGLE_TEXTURE_COMPONENT(unsigned short, ushort)
+__BUGLE_TEXTURE_COMPONENT(int, int)
+__BUGLE_TEXTURE_COMPONENT(unsigned int, uint)
+__BUGLE_TEXTURE_COMPONENT(float, float)
+
+#undef __BUGLE_TEXTURE_COMPONENT
+
+/* The texture read is either a texture object handle or the address of a
+   texture reference */
+
+template <class T> struct __bugle_texel;
+
+#define __BUGLE_TEXEL_SCALAR(TYPE, GATHER) \
+  template <> struct __bugle_texel<TYPE> { \
+    typedef TYPE component_type; \
+    typedef float normalized_type; \
+    typedef GATHER gather_type; \
+    template <class Texture> \
+    __device__ static __inline__ TYPE read(Texture tex, \
+                                          __BUGLE_TEXTURE_PARAMS) { \
+      return __bugle_texture_component<TYPE>::read(tex, \
+        __BUGLE_TEXTURE_ARGS, 0); \
+    } \
+  };
+
+#define __BUGLE_TEXEL_VECTOR(TYPE, NAME) \
+  template <> struct __bugle_texel<NAME##1> { \
+    typedef TYPE component_type; \
+    typedef float1 normalized_type; \
+    typedef NAME##4 gather_type; \
+    template <class Texture> \
+    __device__ static __inline__ NAME##1 read(Texture tex, \
+                                              __BUGLE_TEXTURE_PARAMS) { \
+      return make_##NAME##1( \
+        __bugle_texture_component<TYPE>::read(tex, __BUGLE_TEXTURE_ARGS, 0)); \
+    } \
+  }; \
+  template <> struct __bugle_texel<NAME##2> { \
+    typedef TYPE component_type; \
+    typedef float2 normalized_type; \
+    typedef NAME##4 gather_type; \
+    template <class Texture> \
+    __device__ static __inline__ NAME##2 read(Texture tex, \
+                                              __BUGLE_TEXTURE_PARAMS) { \
+      return make_##NAME##2( \
+        __bugle_texture_component<TYPE>::read(tex, __BUGLE_TEXTURE_ARGS, 0), \
+        __bugle_texture_component<TYPE>::read(tex, __BUGLE_TEXTURE_ARGS, 1)); \
+    } \
+  }; \
+  template <> struct __bugle_texel<NAME##4> { \
+    typedef TYPE component_type; \
+    typedef float4 normalized_type; \
+    typedef NAME##4 gather_type; \
+    template <class Texture> \
+    __device__ static __inline__ NAME##4 read(Texture tex, \
+                                              __BUGLE_TEXTURE_PARAMS) { \
+      return make_##NAME##4( \
+        __bugle_texture_component<TYPE>::read(tex, __BUGLE_TEXTURE_ARGS, 0), \
+        __bugle_texture_component<TYPE>::read(tex, __BUGLE_TEXTURE_ARGS, 1), \
+        __bugle_texture_component<TYPE>::read(tex, __BUGLE_TEXTURE_ARGS, 2), \
+        __bugle_texture_component<TYPE>::read(tex, __BUGLE_TEXTURE_ARGS, 3)); \
+    } \
+  };
+
+__BUGLE_TEXEL_SCALAR(signed char, char4)
+__BUGLE_TEXEL_SCALAR(unsigned char, uchar4)
+__BUGLE_TEXEL_SCALAR(short, short4)
+__BUGLE_TEXEL_SCALAR(unsigned short, ushort4)
+__BUGLE_TEXEL_SCALAR(int, int4)
+__BUGLE_TEXEL_SCALAR(unsigned int, uint4)
+__BUGLE_TEXEL_SCALAR(float, float4)
+
+__BUGLE_TEXEL_VECTOR(signed char, char)
+__BUGLE_TEXEL_VECTOR(unsigned char, uchar)
+__BUGLE_TEXEL_VECTOR(short, short)
+__BUGLE_TEXEL_VECTOR(unsigned short, ushort)
+__BUGLE_TEXEL_VECTOR(int, int)
+__BUGLE_TEXEL_VECTOR(unsigned int, uint)
+__BUGLE_TEXEL_VECTOR(float, float)
+
+#undef __BUGLE_TEXEL_SCALAR
+#undef __BUGLE_TEXEL_VECTOR
+
+/* Plain char is distinct from both signed and unsigned char */
+template <> struct __bugle_texel<char> {
+  typedef char component_type;
+  typedef float normalized_type;
+  typedef char4 gather_type;
+  template <class Texture>
+  __device__ static __inline__ char read(Texture tex, __BUGLE_TEXTURE_PARAMS) {
+    return __bugle_texel<signed char>::read(tex, __BUGLE_TEXTURE_ARGS);
+  }
+};
+
+template <class T, enum cudaTextureReadMode mode>
+struct __bugle_texture_result { typedef T type; };
+template <class T>
+struct __bugle_texture_result<T, cudaReadModeNormalizedFloat> {
+  typedef typename __bugle_texel<T>::normalized_type type;
+};
+
+/* Texture references are taken by reference, so that their address is that
+   of the texture declared, and copying them does not load their fields */
+template <class T, int texType, enum cudaTextureReadMode mode>
+__device__ static __inline__ typename __bugle_texture_result<T, mode>::type
+__bugle_texture_read(const texture<T, texType, mode> &t, int kind, int i,
+                     float x, float y, float z, int layer, float level) {
+  const void *tex = &t;
+  return __bugle_texel<typename __bugle_texture_result<T, mode>::type>::read(
+    tex, kind, i, x, y, z, layer, level);
+}
+
+/* Reads whose result is not modelled */
+template <class T>
+__device__ T __bugle_texture_read_arbitrary(void);
+
+/* texture_fetch_functions.h */
+
+#define __BUGLE_TEXTURE_RESULT typename __bugle_texture_result<T, mode>::type
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex1Dfetch(const texture<T, cudaTextureType1D, mode> &t, int x) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_FETCH, x, 0, 0, 0, 0, 0);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex1D(const texture<T, cudaTextureType1D, mode> &t, float x) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_SAMPLE, 0, x, 0, 0, 0, 0);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex2D(const texture<T, cudaTextureType2D, mode> &t, float x, float y) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_SAMPLE, 0, x, y, 0, 0, 0);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex3D(const texture<T, cudaTextureType3D, mode> &t, float x, float y, float z) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_SAMPLE, 0, x, y, z, 0, 0);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex1DLayered(const texture<T, cudaTextureType1DLayered, mode> &t, float x,
+             int layer) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_SAMPLE, 0, x, 0, 0, layer,
+                              0);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex2DLayered(const texture<T, cudaTextureType2DLayered, mode> &t, float x,
+             float y, int layer) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_SAMPLE, 0, x, y, 0, layer,
+                              0);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+texCubemap(const texture<T, cudaTextureTypeCubemap, mode> &t, float x, float y,
+           float z) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_SAMPLE, 0, x, y, z, 0, 0);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+texCubemapLayered(const texture<T, cudaTextureTypeCubemapLayered, mode> &t,
+                  float x, float y, float z, int layer) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_SAMPLE, 0, x, y, z, layer,
+                              0);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex1DLod(const texture<T, cudaTextureType1D, mode> &t, float x, float level) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_LOD, 0, x, 0, 0, 0, level);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex2DLod(const texture<T, cudaTextureType2D, mode> &t, float x, float y,
+         float level) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_LOD, 0, x, y, 0, 0, level);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex3DLod(const texture<T, cudaTextureType3D, mode> &t, float x, float y,
+         float z, float level) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_LOD, 0, x, y, z, 0, level);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex1DLayeredLod(const texture<T, cudaTextureType1DLayered, mode> &t, float x,
+                int layer, float level) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_LOD, 0, x, 0, 0, layer,
+                              level);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex2DLayeredLod(const texture<T, cudaTextureType2DLayered, mode> &t, float x,
+                float y, int layer, float level) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_LOD, 0, x, y, 0, layer,
+                              level);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+texCubemapLod(const texture<T, cudaTextureTypeCubemap, mode> &t, float x,
+              float y, float z, float level) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_LOD, 0, x, y, z, 0, level);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+texCubemapLayeredLod(const texture<T, cudaTextureTypeCubemapLayered, mode> &t,
+                     float x, float y, float z, int layer, float level) {
+  return __bugle_texture_read(t, __BUGLE_TEXTURE_LOD, 0, x, y, z, layer,
+                              level);
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex1DGrad(const texture<T, cudaTextureType1D, mode> &t, float x, float dPdx,
+          float dPdy) {
+  return __bugle_texture_read_arbitrary<__BUGLE_TEXTURE_RESULT>();
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex2DGrad(const texture<T, cudaTextureType2D, mode> &t, float x, float y,
+          float2 dPdx, float2 dPdy) {
+  return __bugle_texture_read_arbitrary<__BUGLE_TEXTURE_RESULT>();
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex3DGrad(const texture<T, cudaTextureType3D, mode> &t, float x, float y,
+          float z, float4 dPdx, float4 dPdy) {
+  return __bugle_texture_read_arbitrary<__BUGLE_TEXTURE_RESULT>();
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex1DLayeredGrad(const texture<T, cudaTextureType1DLayered, mode> &t, float x,
+                 int layer, float dPdx, float dPdy) {
+  return __bugle_texture_read_arbitrary<__BUGLE_TEXTURE_RESULT>();
+}
+
+template <class T, enum cudaTextureReadMode mode>
+__device__ static __inline__ __BUGLE_TEXTURE_RESULT
+tex2DLayeredGrad(const texture<T, cudaTextureType2DLayered, mode> &t, float x,
+                 float y, int layer, float2 dPdx, float2 dPdy) {
+  return __bugle_texture_read_arbitrary<__BUGLE_TEXTURE_RESULT>();
+}
+
+#undef __BUGLE_TEXTURE_RESULT
+
+template <class T>
+__device__ static __inline__ typename __bugle_texel<T>::gather_type
+tex2Dgather(const texture<T, cudaTextureType2D, cudaReadModeElementType> &t,
+            float x, float y, int comp = 0) {
+  return __bugle_texture_read_arbitrary<
+    typename __bugle_texel<T>::gather_type>();
+}
+
+template <class T>
+__device__ static __inline__ float4
+tex2Dgather(const texture<T, cudaTextureType2D, cudaReadModeNormalizedFloat> &t,
+            float x, float y, int comp = 0) {
+  return __bugle_texture_read_arbitrary<float4>();
+}
 
 /* texture_indirect_functions.h */
 
 template <class T>
-__device__ void tex1Dfetch(T *retVal, cudaTextureObject_t texObject, int x);
+__device__ static __inline__ T tex1Dfetch(cudaTextureObject_t texObject, int x) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_FETCH, x, 0, 0, 0, 0, 0);
+}
 template <class T>
-__device__ T tex1Dfetch(cudaTextureObject_t texObject, int x);
+__device__ static __inline__ void tex1Dfetch(T *retVal, cudaTextureObject_t texObject, int x) {
+  *retVal = tex1Dfetch<T>(texObject, x);
+}
 
 template <class T>
-__device__ void tex1D(T *retVal, cudaTextureObject_t texObject, float x);
+__device__ static __inline__ T tex1D(cudaTextureObject_t texObject, float x) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_SAMPLE, 0, x, 0, 0, 0, 0);
+}
 template <class T>
-__device__ T tex1D(cudaTextureObject_t texObject, float x);
+__device__ static __inline__ void tex1D(T *retVal, cudaTextureObject_t texObject, float x) {
+  *retVal = tex1D<T>(texObject, x);
+}
 
 template <class T>
-__device__ void tex2D(T *retVal, cudaTextureObject_t texObject, float x, float y);
+__device__ static __inline__ T tex2D(cudaTextureObject_t texObject, float x, float y) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_SAMPLE, 0, x, y, 0, 0, 0);
+}
 template <class T>
-__device__ T tex2D(cudaTextureObject_t texObject, float x, float y);
+__device__ static __inline__ void tex2D(T *retVal, cudaTextureObject_t texObject, float x, float y) {
+  *retVal = tex2D<T>(texObject, x, y);
+}
 
 template <class T>
-__device__ void tex3D(T *retVal, cudaTextureObject_t texObject, float x, float y, float z);
+__device__ static __inline__ T tex3D(cudaTextureObject_t texObject, float x, float y, float z) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_SAMPLE, 0, x, y, z, 0, 0);
+}
 template <class T>
-__device__ T tex3D(cudaTextureObject_t texObject, float x, float y, float z);
+__device__ static __inline__ void tex3D(T *retVal, cudaTextureObject_t texObject, float x, float y, float z) {
+  *retVal = tex3D<T>(texObject, x, y, z);
+}
 
 template <class T>
-__device__ void tex1DLayered(T *retVal, cudaTextureObject_t texObject, float x, int layer);
+__device__ static __inline__ T tex1DLayered(cudaTextureObject_t texObject, float x, int layer) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_SAMPLE, 0, x, 0, 0, layer, 0);
+}
 template <class T>
-__device__ T tex1DLayered(cudaTextureObject_t texObject, float x, int layer);
+__device__ static __inline__ void tex1DLayered(T *retVal, cudaTextureObject_t texObject, float x, int layer) {
+  *retVal = tex1DLayered<T>(texObject, x, layer);
+}
 
 template <class T>
-__device__ void tex2DLayered(T *retVal, cudaTextureObject_t texObject, float x, float y, int layer);
+__device__ static __inline__ T tex2DLayered(cudaTextureObject_t texObject, float x, float y, int layer) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_SAMPLE, 0, x, y, 0, layer, 0);
+}
 template <class T>
-__device__ T tex2DLayered(cudaTextureObject_t texObject, float x, float y, int layer);
+__device__ static __inline__ void tex2DLayered(T *retVal, cudaTextureObject_t texObject, float x, float y, int layer) {
+  *retVal = tex2DLayered<T>(texObject, x, y, layer);
+}
 
 template <class T>
-__device__ void texCubemap(T *retVal, cudaTextureObject_t texObject, float x, float y, float z);
+__device__ static __inline__ T texCubemap(cudaTextureObject_t texObject, float x, float y, float z) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_SAMPLE, 0, x, y, z, 0, 0);
+}
 template <class T>
-__device__ T texCubemap(cudaTextureObject_t texObject, float x, float y, float z);
+__device__ static __inline__ void texCubemap(T *retVal, cudaTextureObject_t texObject, float x, float y, float z) {
+  *retVal = texCubemap<T>(texObject, x, y, z);
+}
 
 template <class T>
-__device__ void texCubemapLayered(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, int layer);
+__device__ static __inline__ T texCubemapLayered(cudaTextureObject_t texObject, float x, float y, float z, int layer) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_SAMPLE, 0, x, y, z, layer, 0);
+}
 template <class T>
-__device__ T texCubemapLayered(cudaTextureObject_t texObject, float x, float y, float z, int layer);
+__device__ static __inline__ void texCubemapLayered(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, int layer) {
+  *retVal = texCubemapLayered<T>(texObject, x, y, z, layer);
+}
 
 template <class T>
-__device__ void tex2Dgather(T *retVal, cudaTextureObject_t texObject, float x, float y, int comp = 0);
+__device__ static __inline__ T tex2Dgather(cudaTextureObject_t texObject, float x, float y, int comp = 0) {
+  return __bugle_texture_read_arbitrary<T>();
+}
 template <class T>
-__device__ T tex2Dgather(cudaTextureObject_t to, float x, float y, int comp = 0);
+__device__ static __inline__ void tex2Dgather(T *retVal, cudaTextureObject_t texObject, float x, float y, int comp = 0) {
+  *retVal = tex2Dgather<T>(texObject, x, y, comp);
+}
 
 template <class T>
-__device__ void tex1DLod(T *retVal, cudaTextureObject_t texObject, float x, float level);
+__device__ static __inline__ T tex1DLod(cudaTextureObject_t texObject, float x, float level) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_LOD, 0, x, 0, 0, 0, level);
+}
 template <class T>
-__device__ T tex1DLod(cudaTextureObject_t texObject, float x, float level);
+__device__ static __inline__ void tex1DLod(T *retVal, cudaTextureObject_t texObject, float x, float level) {
+  *retVal = tex1DLod<T>(texObject, x, level);
+}
 
 template <class T>
-__device__ void tex2DLod(T *retVal, cudaTextureObject_t texObject, float x, float y, float level);
+__device__ static __inline__ T tex2DLod(cudaTextureObject_t texObject, float x, float y, float level) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_LOD, 0, x, y, 0, 0, level);
+}
 template <class T>
-__device__ T tex2DLod(cudaTextureObject_t texObject, float x, float y, float level);
+__device__ static __inline__ void tex2DLod(T *retVal, cudaTextureObject_t texObject, float x, float y, float level) {
+  *retVal = tex2DLod<T>(texObject, x, y, level);
+}
 
 template <class T>
-__device__ void tex3DLod(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, float level);
+__device__ static __inline__ T tex3DLod(cudaTextureObject_t texObject, float x, float y, float z, float level) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_LOD, 0, x, y, z, 0, level);
+}
 template <class T>
-__device__ T tex3DLod(cudaTextureObject_t texObject, float x, float y, float z, float level);
+__device__ static __inline__ void tex3DLod(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, float level) {
+  *retVal = tex3DLod<T>(texObject, x, y, z, level);
+}
 
 template <class T>
-__device__ void tex1DLayeredLod(T *retVal, cudaTextureObject_t texObject, float x, int layer, float level);
+__device__ static __inline__ T tex1DLayeredLod(cudaTextureObject_t texObject, float x, int layer, float level) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_LOD, 0, x, 0, 0, layer, level);
+}
 template <class T>
-__device__ T tex1DLayeredLod(cudaTextureObject_t texObject, float x, int layer, float level);
+__device__ static __inline__ void tex1DLayeredLod(T *retVal, cudaTextureObject_t texObject, float x, int layer, float level) {
+  *retVal = tex1DLayeredLod<T>(texObject, x, layer, level);
+}
 
 template <class T>
-__device__ void tex2DLayeredLod(T *retVal, cudaTextureObject_t texObject, float x, float y, int layer, float level);
+__device__ static __inline__ T tex2DLayeredLod(cudaTextureObject_t texObject, float x, float y, int layer, float level) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_LOD, 0, x, y, 0, layer, level);
+}
 template <class T>
-__device__ T tex2DLayeredLod(cudaTextureObject_t texObject, float x, float y, int layer, float level);
+__device__ static __inline__ void tex2DLayeredLod(T *retVal, cudaTextureObject_t texObject, float x, float y, int layer, float level) {
+  *retVal = tex2DLayeredLod<T>(texObject, x, y, layer, level);
+}
 
 template <class T>
-__device__ void texCubemapLod(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, float level);
+__device__ static __inline__ T texCubemapLod(cudaTextureObject_t texObject, float x, float y, float z, float level) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_LOD, 0, x, y, z, 0, level);
+}
 template <class T>
-__device__ T texCubemapLod(cudaTextureObject_t texObject, float x, float y, float z, float level);
+__device__ static __inline__ void texCubemapLod(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, float level) {
+  *retVal = texCubemapLod<T>(texObject, x, y, z, level);
+}
 
 template <class T>
-__device__ void texCubemapLayeredLod(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, int layer, float level);
+__device__ static __inline__ T texCubemapLayeredLod(cudaTextureObject_t texObject, float x, float y, float z, int layer, float level) {
+  return __bugle_texel<T>::read(texObject, __BUGLE_TEXTURE_LOD, 0, x, y, z, layer, level);
+}
 template <class T>
-__device__ T texCubemapLayeredLod(cudaTextureObject_t texObject, float x, float y, float z, int layer, float level);
+__device__ static __inline__ void texCubemapLayeredLod(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, int layer, float level) {
+  *retVal = texCubemapLayeredLod<T>(texObject, x, y, z, layer, level);
+}
 
 template <class T>
-__device__ void tex1DGrad(T *retVal, cudaTextureObject_t texObject, float x, float dPdx, float dPdy);
+__device__ static __inline__ T tex1DGrad(cudaTextureObject_t texObject, float x, float dPdx, float dPdy) {
+  return __bugle_texture_read_arbitrary<T>();
+}
 template <class T>
-__device__ T tex1DGrad(cudaTextureObject_t texObject, float x, float dPdx, float dPdy);
+__device__ static __inline__ void tex1DGrad(T *retVal, cudaTextureObject_t texObject, float x, float dPdx, float dPdy) {
+  *retVal = tex1DGrad<T>(texObject, x, dPdx, dPdy);
+}
 
 template <class T>
-__device__ void tex2DGrad(T *retVal, cudaTextureObject_t texObject, float x, float y, float2 dPdx, float2 dPdy);
+__device__ static __inline__ T tex2DGrad(cudaTextureObject_t texObject, float x, float y, float2 dPdx, float2 dPdy) {
+  return __bugle_texture_read_arbitrary<T>();
+}
 template <class T>
-__device__ T tex2DGrad(cudaTextureObject_t texObject, float x, float y, float2 dPdx, float2 dPdy);
+__device__ static __inline__ void tex2DGrad(T *retVal, cudaTextureObject_t texObject, float x, float y, float2 dPdx, float2 dPdy) {
+  *retVal = tex2DGrad<T>(texObject, x, y, dPdx, dPdy);
+}
 
 template <class T>
-__device__ void tex3DGrad(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, float4 dPdx, float4 dPdy);
+__device__ static __inline__ T tex3DGrad(cudaTextureObject_t texObject, float x, float y, float z, float4 dPdx, float4 dPdy) {
+  return __bugle_texture_read_arbitrary<T>();
+}
 template <class T>
-__device__ T tex3DGrad(cudaTextureObject_t texObject, float x, float y, float z, float4 dPdx, float4 dPdy);
+__device__ static __inline__ void tex3DGrad(T *retVal, cudaTextureObject_t texObject, float x, float y, float z, float4 dPdx, float4 dPdy) {
+  *retVal = tex3DGrad<T>(texObject, x, y, z, dPdx, dPdy);
+}
 
 template <class T>
-__device__ void tex1DLayeredGrad(T *retVal, cudaTextureObject_t texObject, float x, int layer, float dPdx, float dPdy);
+__device__ static __inline__ T tex1DLayeredGrad(cudaTextureObject_t texObject, float x, int layer, float dPdx, float dPdy) {
+  return __bugle_texture_read_arbitrary<T>();
+}
 template <class T>
-__device__ T tex1DLayeredGrad(cudaTextureObject_t texObject, float x, int layer, float dPdx, float dPdy);
+__device__ static __inline__ void tex1DLayeredGrad(T *retVal, cudaTextureObject_t texObject, float x, int layer, float dPdx, float dPdy) {
+  *retVal = tex1DLayeredGrad<T>(texObject, x, layer, dPdx, dPdy);
+}
 
 template <class T>
-__device__ void tex2DLayeredGrad(T *retVal, cudaTextureObject_t texObject, float x, float y, int layer, float2 dPdx, float2 dPdy);
+__device__ static __inline__ T tex2DLayeredGrad(cudaTextureObject_t texObject, float x, float y, int layer, float2 dPdx, float2 dPdy) {
+  return __bugle_texture_read_arbitrary<T>();
+}
 template <class T>
-__device__ T tex2DLayeredGrad(cudaTextureObject_t texObject, float x, float y, int layer, float2 dPdx, float2 dPdy);
+__device__ static __inline__ void tex2DLayeredGrad(T *retVal, cudaTextureObject_t texObject, float x, float y, int layer, float2 dPdx, float2 dPdy) {
+  *retVal = tex2DLayeredGrad<T>(texObject, x, y, layer, dPdx, dPdy);
+}
 
 #endif
@@ -10,19 +10,31 @@ typedef unsigned int uint;
 /* See Table B-1 in CUDA Specification */
 /* From vector_functions.h */
 
+#ifdef __BUGLE_NATIVE_VECTORS
+/* Two- and four-component vectors are clang extended vectors, as in OpenCL,
+   so that loads and stores of these are single accesses of the whole vector.
+   Three-component vectors remain structs, as their size is not a power of
+   two. Extended vectors come with element-wise operators built in. */
+#define __MAKE_NATIVE_VECTOR(TYPE,NAME,SIZE,...) \
+  typedef TYPE NAME __attribute__((ext_vector_type(SIZE)));
+#define __STRUCT_VECTOR_ONLY(...)
+#else
+#define __MAKE_NATIVE_VECTOR(TYPE,NAME,SIZE,...) \
+  typedef struct {   \
+    TYPE __VA_ARGS__; \
+  } NAME;
+#define __STRUCT_VECTOR_ONLY(...) __VA_ARGS__
+#endif
+
 #define __MAKE_VECTOR_OPERATIONS(TYPE,NAME) \
   typedef struct {   \
     TYPE x;          \
   } NAME##1;         \
-  typedef struct {   \
-    TYPE x, y;       \
-  } NAME##2;         \
+  __MAKE_NATIVE_VECTOR(TYPE, NAME##2, 2, x, y) \
   typedef struct {   \
     TYPE x, y, z;    \
   } NAME##3;         \
-  typedef struct {   \
-    TYPE x, y, z, w; \
-  } NAME##4;         \
+  __MAKE_NATIVE_VECTOR(TYPE, NAME##4, 4, x, y, z, w) \
   __host__ __device__ static __inline__ NAME##1 make_##NAME##1(TYPE x) \
   { \
     return { x }; \
@@ -66,6 +78,7 @@ __MAKE_VECTOR_OPERATIONS(float,float)
 __MAKE_VECTOR_OPERATIONS(double,double)
 
 #undef __MAKE_VECTOR_OPERATIONS
+#undef __MAKE_NATIVE_VECTOR
 
 /* from helper_math.h */
 
@@ -130,18 +143,22 @@ __host__ __device__ static __inline__ uint3 make_uint3(uint4 a)
 }
 
 #define __MAKE_NEGATIVE(TYPE) \
-  __device__ static __inline__ TYPE##2 operator-(TYPE##2 &a) \
-  { \
-    return make_##TYPE##2(-a.x, -a.y); \
-  } \
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##2 operator-(TYPE##2 &a) \
+    { \
+      return make_##TYPE##2(-a.x, -a.y); \
+    } \
+  ) \
   __device__ static __inline__ TYPE##3 operator-(TYPE##3 &a) \
   { \
     return make_##TYPE##3(-a.x, -a.y, -a.z); \
   } \
-  __device__ static __inline__ TYPE##4 operator-(TYPE##4 &a) \
-  { \
-    return make_##TYPE##4(-a.x, -a.y, -a.z, -a.w); \
-  }
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##4 operator-(TYPE##4 &a) \
+    { \
+      return make_##TYPE##4(-a.x, -a.y, -a.z, -a.w); \
+    } \
+  )
 
 __MAKE_NEGATIVE(float)
 __MAKE_NEGATIVE(int)
@@ -149,26 +166,28 @@ __MAKE_NEGATIVE(int)
 #undef __MAKE_NEGATIVE
 
 #define __MAKE_PLUS(TYPE) \
-  __device__ static __inline__ TYPE##2 operator+(TYPE##2 a, TYPE##2 b) \
-  { \
-    return make_##TYPE##2(a.x + b.x, a.y + b.y); \
-  } \
-  __device__ static __inline__ void operator+=(TYPE##2 &a, TYPE##2 b) \
-  { \
-    a = make_##TYPE##2(a.x + b.x, a.y + b.y); \
-  } \
-  __device__ static __inline__ TYPE##2 operator+(TYPE##2 a, TYPE b) \
-  { \
-    return make_##TYPE##2(a.x + b, a.y + b); \
-  } \
-  __device__ static __inline__ TYPE##2 operator+(TYPE a, TYPE##2 b) \
-  { \
-    return make_##TYPE##2(a + b.x, a + b.y); \
-  } \
-  __device__ static __inline__ void operator+=(TYPE##2 &a, TYPE b) \
-  { \
-    a = make_##TYPE##2(a.x + b, a.y + b); \
-  } \
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##2 operator+(TYPE##2 a, TYPE##2 b) \
+    { \
+      return make_##TYPE##2(a.x + b.x, a.y + b.y); \
+    } \
+    __device__ static __inline__ void operator+=(TYPE##2 &a, TYPE##2 b) \
+    { \
+      a = make_##TYPE##2(a.x + b.x, a.y + b.y); \
+    } \
+    __device__ static __inline__ TYPE##2 operator+(TYPE##2 a, TYPE b) \
+    { \
+      return make_##TYPE##2(a.x + b, a.y + b); \
+    } \
+    __device__ static __inline__ TYPE##2 operator+(TYPE a, TYPE##2 b) \
+    { \
+      return make_##TYPE##2(a + b.x, a + b.y); \
+    } \
+    __device__ static __inline__ void operator+=(TYPE##2 &a, TYPE b) \
+    { \
+      a = make_##TYPE##2(a.x + b, a.y + b); \
+    } \
+  ) \
   __device__ static __inline__ TYPE##3 operator+(TYPE##3 a, TYPE##3 b) \
   { \
     return make_##TYPE##3(a.x + b.x, a.y + b.y, a.z + b.z); \
@@ -189,26 +208,28 @@ __MAKE_NEGATIVE(int)
   { \
     a = make_##TYPE##3(a.x + b, a.y + b, a.z + b); \
   } \
-  __device__ static __inline__ TYPE##4 operator+(TYPE##4 a, TYPE##4 b) \
-  { \
-    return make_##TYPE##4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); \
-  } \
-  __device__ static __inline__ void operator+=(TYPE##4 &a, TYPE##4 b) \
-  { \
-    a = make_##TYPE##4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); \
-  } \
-  __device__ static __inline__ TYPE##4 operator+(TYPE##4 a, TYPE b) \
-  { \
-    return make_##TYPE##4(a.x + b, a.y + b, a.z + b, a.w + b); \
-  } \
-  __device__ static __inline__ TYPE##4 operator+(TYPE a, TYPE##4 b) \
-  { \
-    return make_##TYPE##4(a + b.x, a + b.y, a + b.z, a + b.w); \
-  } \
-  __device__ static __inline__ void operator+=(TYPE##4 &a, TYPE b) \
-  { \
-    a = make_##TYPE##4(a.x + b, a.y + b, a.z + b, a.w + b); \
-  }
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##4 operator+(TYPE##4 a, TYPE##4 b) \
+    { \
+      return make_##TYPE##4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); \
+    } \
+    __device__ static __inline__ void operator+=(TYPE##4 &a, TYPE##4 b) \
+    { \
+      a = make_##TYPE##4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); \
+    } \
+    __device__ static __inline__ TYPE##4 operator+(TYPE##4 a, TYPE b) \
+    { \
+      return make_##TYPE##4(a.x + b, a.y + b, a.z + b, a.w + b); \
+    } \
+    __device__ static __inline__ TYPE##4 operator+(TYPE a, TYPE##4 b) \
+    { \
+      return make_##TYPE##4(a + b.x, a + b.y, a + b.z, a + b.w); \
+    } \
+    __device__ static __inline__ void operator+=(TYPE##4 &a, TYPE b) \
+    { \
+      a = make_##TYPE##4(a.x + b, a.y + b, a.z + b, a.w + b); \
+    } \
+  )
 
 __MAKE_PLUS(float)
 __MAKE_PLUS(int)
@@ -217,26 +238,28 @@ __MAKE_PLUS(uint)
 #undef __MAKE_PLUS
 
 #define __MAKE_MINUS(TYPE) \
-  __device__ static __inline__ TYPE##2 operator-(TYPE##2 a, TYPE##2 b) \
-  { \
-    return make_##TYPE##2(a.x - b.x, a.y - b.y); \
-  } \
-  __device__ static __inline__ void operator-=(TYPE##2 &a, TYPE##2 b) \
-  { \
-    a = make_##TYPE##2(a.x - b.x, a.y - b.y); \
-  } \
-  __device__ static __inline__ TYPE##2 operator-(TYPE##2 a, TYPE b) \
-  { \
-    return make_##TYPE##2(a.x - b, a.y - b); \
-  } \
-  __device__ static __inline__ TYPE##2 operator-(TYPE a, TYPE##2 b) \
-  { \
-    return make_##TYPE##2(a - b.x, a - b.y); \
-  } \
-  __device__ static __inline__ void operator-=(TYPE##2 &a, TYPE b) \
-  { \
-    a = make_##TYPE##2(a.x - b, a.y - b); \
-  } \
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##2 operator-(TYPE##2 a, TYPE##2 b) \
+    { \
+      return make_##TYPE##2(a.x - b.x, a.y - b.y); \
+    } \
+    __device__ static __inline__ void operator-=(TYPE##2 &a, TYPE##2 b) \
+    { \
+      a = make_##TYPE##2(a.x - b.x, a.y - b.y); \
+    } \
+    __device__ static __inline__ TYPE##2 operator-(TYPE##2 a, TYPE b) \
+    { \
+      return make_##TYPE##2(a.x - b, a.y - b); \
+    } \
+    __device__ static __inline__ TYPE##2 operator-(TYPE a, TYPE##2 b) \
+    { \
+      return make_##TYPE##2(a - b.x, a - b.y); \
+    } \
+    __device__ static __inline__ void operator-=(TYPE##2 &a, TYPE b) \
+    { \
+      a = make_##TYPE##2(a.x - b, a.y - b); \
+    } \
+  ) \
   __device__ static __inline__ TYPE##3 operator-(TYPE##3 a, TYPE##3 b) \
   { \
     return make_##TYPE##3(a.x - b.x, a.y - b.y, a.z - b.z); \
@@ -257,26 +280,28 @@ __MAKE_PLUS(uint)
   { \
     a = make_##TYPE##3(a.x - b, a.y - b, a.z - b); \
   } \
-  __device__ static __inline__ TYPE##4 operator-(TYPE##4 a, TYPE##4 b) \
-  { \
-    return make_##TYPE##4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w); \
-  } \
-  __device__ static __inline__ void operator-=(TYPE##4 &a, TYPE##4 b) \
-  { \
-    a = make_##TYPE##4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w); \
-  } \
-  __device__ static __inline__ TYPE##4 operator-(TYPE##4 a, TYPE b) \
-  { \
-    return make_##TYPE##4(a.x - b, a.y - b, a.z - b, a.w - b); \
-  } \
-  __device__ static __inline__ TYPE##4 operator-(TYPE a, TYPE##4 b) \
-  { \
-    return make_##TYPE##4(a - b.x, a - b.y, a - b.z, a - b.w); \
-  } \
-  __device__ static __inline__ void operator-=(TYPE##4 &a, TYPE b) \
-  { \
-    a = make_##TYPE##4(a.x - b, a.y - b, a.z - b, a.w - b); \
-  }
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##4 operator-(TYPE##4 a, TYPE##4 b) \
+    { \
+      return make_##TYPE##4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w); \
+    } \
+    __device__ static __inline__ void operator-=(TYPE##4 &a, TYPE##4 b) \
+    { \
+      a = make_##TYPE##4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w); \
+    } \
+    __device__ static __inline__ TYPE##4 operator-(TYPE##4 a, TYPE b) \
+    { \
+      return make_##TYPE##4(a.x - b, a.y - b, a.z - b, a.w - b); \
+    } \
+    __device__ static __inline__ TYPE##4 operator-(TYPE a, TYPE##4 b) \
+    { \
+      return make_##TYPE##4(a - b.x, a - b.y, a - b.z, a - b.w); \
+    } \
+    __device__ static __inline__ void operator-=(TYPE##4 &a, TYPE b) \
+    { \
+      a = make_##TYPE##4(a.x - b, a.y - b, a.z - b, a.w - b); \
+    } \
+  )
 
 __MAKE_MINUS(float)
 __MAKE_MINUS(int)
@@ -285,26 +310,28 @@ __MAKE_MINUS(uint)
 #undef __MAKE_MINUS
 
 #define __MAKE_TIMES(TYPE) \
-  __device__ static __inline__ TYPE##2 operator*(TYPE##2 a, TYPE##2 b) \
-  { \
-    return make_##TYPE##2(a.x * b.x, a.y * b.y); \
-  } \
-  __device__ static __inline__ void operator*=(TYPE##2 &a, TYPE##2 b) \
-  { \
-    a = make_##TYPE##2(a.x * b.x, a.y * b.y); \
-  } \
-  __device__ static __inline__ TYPE##2 operator*(TYPE##2 a, TYPE b) \
-  { \
-    return make_##TYPE##2(a.x * b, a.y * b); \
-  } \
-  __device__ static __inline__ TYPE##2 operator*(TYPE a, TYPE##2 b) \
-  { \
-    return make_##TYPE##2(a * b.x, a * b.y); \
-  } \
-  __device__ static __inline__ void operator*=(TYPE##2 &a, TYPE b) \
-  { \
-    a = make_##TYPE##2(a.x * b, a.y * b); \
-  } \
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##2 operator*(TYPE##2 a, TYPE##2 b) \
+    { \
+      return make_##TYPE##2(a.x * b.x, a.y * b.y); \
+    } \
+    __device__ static __inline__ void operator*=(TYPE##2 &a, TYPE##2 b) \
+    { \
+      a = make_##TYPE##2(a.x * b.x, a.y * b.y); \
+    } \
+    __device__ static __inline__ TYPE##2 operator*(TYPE##2 a, TYPE b) \
+    { \
+      return make_##TYPE##2(a.x * b, a.y * b); \
+    } \
+    __device__ static __inline__ TYPE##2 operator*(TYPE a, TYPE##2 b) \
+    { \
+      return make_##TYPE##2(a * b.x, a * b.y); \
+    } \
+    __device__ static __inline__ void operator*=(TYPE##2 &a, TYPE b) \
+    { \
+      a = make_##TYPE##2(a.x * b, a.y * b); \
+    } \
+  ) \
   __device__ static __inline__ TYPE##3 operator*(TYPE##3 a, TYPE##3 b) \
   { \
     return make_##TYPE##3(a.x * b.x, a.y * b.y, a.z * b.z); \
@@ -325,26 +352,28 @@ __MAKE_MINUS(uint)
   { \
     a = make_##TYPE##3(a.x * b, a.y * b, a.z * b); \
   } \
-  __device__ static __inline__ TYPE##4 operator*(TYPE##4 a, TYPE##4 b) \
-  { \
-    return make_##TYPE##4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w); \
-  } \
-  __device__ static __inline__ void operator*=(TYPE##4 &a, TYPE##4 b) \
-  { \
-    a = make_##TYPE##4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w); \
-  } \
-  __device__ static __inline__ TYPE##4 operator*(TYPE##4 a, TYPE b) \
-  { \
-    return make_##TYPE##4(a.x * b, a.y * b, a.z * b, a.w * b); \
-  } \
-  __device__ static __inline__ TYPE##4 operator*(TYPE a, TYPE##4 b) \
-  { \
-    return make_##TYPE##4(a * b.x, a * b.y, a * b.z, a * b.w); \
-  } \
-  __device__ static __inline__ void operator*=(TYPE##4 &a, TYPE b) \
-  { \
-    a = make_##TYPE##4(a.x * b, a.y * b, a.z * b, a.w * b); \
-  }
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##4 operator*(TYPE##4 a, TYPE##4 b) \
+    { \
+      return make_##TYPE##4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w); \
+    } \
+    __device__ static __inline__ void operator*=(TYPE##4 &a, TYPE##4 b) \
+    { \
+      a = make_##TYPE##4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w); \
+    } \
+    __device__ static __inline__ TYPE##4 operator*(TYPE##4 a, TYPE b) \
+    { \
+      return make_##TYPE##4(a.x * b, a.y * b, a.z * b, a.w * b); \
+    } \
+    __device__ static __inline__ TYPE##4 operator*(TYPE a, TYPE##4 b) \
+    { \
+      return make_##TYPE##4(a * b.x, a * b.y, a * b.z, a * b.w); \
+    } \
+    __device__ static __inline__ void operator*=(TYPE##4 &a, TYPE b) \
+    { \
+      a = make_##TYPE##4(a.x * b, a.y * b, a.z * b, a.w * b); \
+    } \
+  )
 
 __MAKE_TIMES(float)
 __MAKE_TIMES(int)
@@ -353,26 +382,28 @@ __MAKE_TIMES(uint)
 #undef __MAKE_TIMES
 
 #define __MAKE_DIVIDE(TYPE) \
-  __device__ static __inline__ TYPE##2 operator/(TYPE##2 a, TYPE##2 b) \
-  { \
-    return make_##TYPE##2(a.x / b.x, a.y / b.y); \
-  } \
-  __device__ static __inline__ void operator/=(TYPE##2 &a, TYPE##2 b) \
-  { \
-    a = make_##TYPE##2(a.x / b.x, a.y / b.y); \
-  } \
-  __device__ static __inline__ TYPE##2 operator/(TYPE##2 a, TYPE b) \
-  { \
-    return make_##TYPE##2(a.x / b, a.y / b); \
-  } \
-  __device__ static __inline__ TYPE##2 operator/(TYPE a, TYPE##2 b) \
-  { \
-    return make_##TYPE##2(a / b.x, a / b.y); \
-  } \
-  __device__ static __inline__ void operator/=(TYPE##2 &a, TYPE b) \
-  { \
-    a = make_##TYPE##2(a.x / b, a.y / b); \
-  } \
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##2 operator/(TYPE##2 a, TYPE##2 b) \
+    { \
+      return make_##TYPE##2(a.x / b.x, a.y / b.y); \
+    } \
+    __device__ static __inline__ void operator/=(TYPE##2 &a, TYPE##2 b) \
+    { \
+      a = make_##TYPE##2(a.x / b.x, a.y / b.y); \
+    } \
+    __device__ static __inline__ TYPE##2 operator/(TYPE##2 a, TYPE b) \
+    { \
+      return make_##TYPE##2(a.x / b, a.y / b); \
+    } \
+    __device__ static __inline__ TYPE##2 operator/(TYPE a, TYPE##2 b) \
+    { \
+      return make_##TYPE##2(a / b.x, a / b.y); \
+    } \
+    __device__ static __inline__ void operator/=(TYPE##2 &a, TYPE b) \
+    { \
+      a = make_##TYPE##2(a.x / b, a.y / b); \
+    } \
+  ) \
   __device__ static __inline__ TYPE##3 operator/(TYPE##3 a, TYPE##3 b) \
   { \
     return make_##TYPE##3(a.x / b.x, a.y / b.y, a.z / b.z); \
@@ -393,26 +424,28 @@ __MAKE_TIMES(uint)
   { \
     a = make_##TYPE##3(a.x / b, a.y / b, a.z / b); \
   } \
-  __device__ static __inline__ TYPE##4 operator/(TYPE##4 a, TYPE##4 b) \
-  { \
-    return make_##TYPE##4(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w); \
-  } \
-  __device__ static __inline__ void operator/=(TYPE##4 &a, TYPE##4 b) \
-  { \
-    a = make_##TYPE##4(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w); \
-  } \
-  __device__ static __inline__ TYPE##4 operator/(TYPE##4 a, TYPE b) \
-  { \
-    return make_##TYPE##4(a.x / b, a.y / b, a.z / b, a.w / b); \
-  } \
-  __device__ static __inline__ TYPE##4 operator/(TYPE a, TYPE##4 b) \
-  { \
-    return make_##TYPE##4(a / b.x, a / b.y, a / b.z, a / b.w); \
-  } \
-  __device__ static __inline__ void operator/=(TYPE##4 &a, TYPE b) \
-  { \
-    a = make_##TYPE##4(a.x / b, a.y / b, a.z / b, a.w / b); \
-  }
+  __STRUCT_VECTOR_ONLY( \
+    __device__ static __inline__ TYPE##4 operator/(TYPE##4 a, TYPE##4 b) \
+    { \
+      return make_##TYPE##4(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w); \
+    } \
+    __device__ static __inline__ void operator/=(TYPE##4 &a, TYPE##4 b) \
+    { \
+      a = make_##TYPE##4(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w); \
+    } \
+    __device__ static __inline__ TYPE##4 operator/(TYPE##4 a, TYPE b) \
+    { \
+      return make_##TYPE##4(a.x / b, a.y / b, a.z / b, a.w / b); \
+    } \
+    __device__ static __inline__ TYPE##4 operator/(TYPE a, TYPE##4 b) \
+    { \
+      return make_##TYPE##4(a / b.x, a / b.y, a / b.z, a / b.w); \
+    } \
+    __device__ static __inline__ void operator/=(TYPE##4 &a, TYPE b) \
+    { \
+      a = make_##TYPE##4(a.x / b, a.y / b, a.z / b, a.w / b); \
+    } \
+  )
 
 __MAKE_DIVIDE(float)
 
@@ -521,6 +554,8 @@ __device__ float2 smoothstep(float2 a, float2 b, float2 x);
 __device__ float3 smoothstep(float3 a, float3 b, float3 x);
 __device__ float4 smoothstep(float4 a, float4 b, float4 x);
 
+#undef __STRUCT_VECTOR_ONLY
+
 #pragma GCC diagnostic pop
 
 #endif
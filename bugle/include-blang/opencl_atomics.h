@@ -5,78 +5,47 @@ typedef __global unsigned int * counter32_t;
 
 #ifdef __OPENCL_VERSION__
 
-#define ATOM_DECL(OP) \
-    long __bugle_atomic_##OP##_global_long(volatile __global long * x, long y); \
-    unsigned long __bugle_atomic_##OP##_global_unsigned_long(volatile __global unsigned long * x, unsigned long y); \
-    long __bugle_atomic_##OP##_local_long(volatile __local long * x, long y); \
-    unsigned long __bugle_atomic_##OP##_local_unsigned_long(volatile __local unsigned long * x, unsigned long y); \
-    _CLC_INLINE _CLC_OVERLOAD long atom_##OP(volatile __global long * x, long y) { \
-      return __bugle_atomic_##OP##_global_long(x, y); \
-    } \
-    _CLC_INLINE _CLC_OVERLOAD unsigned long atom_##OP(volatile __global unsigned long * x, unsigned long y) { \
-      return __bugle_atomic_##OP##_global_unsigned_long(x, y); \
-    } \
-    _CLC_INLINE _CLC_OVERLOAD long atom_##OP(volatile __local long * x, long y) { \
-      return __bugle_atomic_##OP##_local_long(x, y); \
-    } \
-    _CLC_INLINE _CLC_OVERLOAD unsigned long atom_##OP(volatile __local unsigned long * x, unsigned long y) { \
-      return __bugle_atomic_##OP##_local_unsigned_long(x, y); \
-    }
-
-ATOM_DECL(add)
-ATOM_DECL(sub)
-ATOM_DECL(xchg)
-/*ATOM_DECL(cmpxchg)*/
-ATOM_DECL(min)
-ATOM_DECL(max)
-ATOM_DECL(and)
-ATOM_DECL(or)
-ATOM_DECL(xor)
-
-#undef ATOM_DECL
+#include <bugle_atomics.h>
+
+#define ATOM_SPACE_DECL(OP, ARITY, SPACE) \
+    __BUGLE_ATOMIC(_CLC_INLINE _CLC_OVERLOAD, atom_##OP, \
+      __bugle_atomic_##OP##_##SPACE##_long, ARITY, __##SPACE, long) \
+    __BUGLE_ATOMIC(_CLC_INLINE _CLC_OVERLOAD, atom_##OP, \
+      __bugle_atomic_##OP##_##SPACE##_unsigned_long, ARITY, __##SPACE, \
+      unsigned long)
+
+#define ATOM_DECL(OP, ARITY) \
+    ATOM_SPACE_DECL(OP, ARITY, global) \
+    ATOM_SPACE_DECL(OP, ARITY, local)
+
+ATOM_DECL(add, 2)
+ATOM_DECL(sub, 2)
+ATOM_DECL(xchg, 2)
+ATOM_DECL(min, 2)
+ATOM_DECL(max, 2)
+ATOM_DECL(and, 2)
+ATOM_DECL(or, 2)
+ATOM_DECL(xor, 2)
 
 /* TYPE atom_cmpxchg(TYPE*,TYPE,TYPE) */
 /* atom_cmpxchg(p, cmp, val), computes (old == cmp) ? val : old */
+ATOM_DECL(cmpxchg, 3)
 
-long __bugle_atomic_cmpxchg_global_long(volatile __global long * x, long y, long z);
-unsigned long __bugle_atomic_cmpxchg_global_unsigned_long(volatile __global unsigned long * x, unsigned long y, unsigned long z);
-long __bugle_atomic_cmpxchg_local_long(volatile __local long * x, long y, long z);
-unsigned long __bugle_atomic_cmpxchg_local_unsigned_long(volatile __local unsigned long * x, unsigned long y, unsigned long z);
-_CLC_INLINE _CLC_OVERLOAD long atom_cmpxchg(volatile __global long * x, long y, long z) {
-  return __bugle_atomic_cmpxchg_global_long(x, y, z);
-}
-_CLC_INLINE _CLC_OVERLOAD unsigned long atom_cmpxchg(volatile __global unsigned long * x, unsigned long y, unsigned long z) {
-  return __bugle_atomic_cmpxchg_global_unsigned_long(x, y, z);
-}
-_CLC_INLINE _CLC_OVERLOAD long atom_cmpxchg(volatile __local long * x, long y, long z) {
-  return __bugle_atomic_cmpxchg_local_long(x, y, z);
-}
-_CLC_INLINE _CLC_OVERLOAD unsigned long atom_cmpxchg(volatile __local unsigned long * x, unsigned long y, unsigned long z) {
-  return __bugle_atomic_cmpxchg_local_unsigned_long(x, y, z);
-}
+ATOM_DECL(inc, 1)
+ATOM_DECL(dec, 1)
 
-#define ATOM_SINGLE_DECL(OP) \
-    long __bugle_atomic_##OP##_global_long(volatile __global long * x); \
-    unsigned long __bugle_atomic_##OP##_global_unsigned_long(volatile __global unsigned long * x); \
-    long __bugle_atomic_##OP##_local_long(volatile __local long * x); \
-    unsigned long __bugle_atomic_##OP##_local_unsigned_long(volatile __local unsigned long * x); \
-    _CLC_INLINE _CLC_OVERLOAD long atom_##OP(volatile __global long * x) { \
-      return __bugle_atomic_##OP##_global_long(x); \
-    } \
-    _CLC_INLINE _CLC_OVERLOAD unsigned long atom_##OP(volatile __global unsigned long * x) { \
-      return __bugle_atomic_##OP##_global_unsigned_long(x); \
-    } \
-    _CLC_INLINE _CLC_OVERLOAD long atom_##OP(volatile __local long * x) { \
-      return __bugle_atomic_##OP##_local_long(x); \
-    } \
-    _CLC_INLINE _CLC_OVERLOAD unsigned long atom_##OP(volatile __local unsigned long * x) { \
-      return __bugle_atomic_##OP##_local_unsigned_long(x); \
-    }
-
-ATOM_SINGLE_DECL(inc)
-ATOM_SINGLE_DECL(dec)
+#undef ATOM_DECL
+#undef ATOM_SPACE_DECL
+
+#ifdef __BUGLE_ATOMIC_COUNTERS
+#undef atomic_add
+#define atomic_add(x, y) \
+    __BUGLE_ATOMIC_ADD_OR_INC(y, __bugle_atomic_add(x, y), __bugle_atomic_inc(x))
+#undef atom_add
+#define atom_add(x, y) \
+    __BUGLE_ATOMIC_ADD_OR_INC(y, __bugle_atom_add(x, y), __bugle_atom_inc(x))
+#endif
 
-#undef ATOM_SINGLE_DECL
 #endif
 
 #endif
@@ -0,0 +1,161 @@
+#!/usr/bin/env python
+# vim: set shiftwidth=2 tabstop=2 expandtab softtabstop=2:
+"""Split the SMT-LIB logs written by GPUVerify's --gen-smt2 into standalone
+queries, deduplicate them across kernels and runs, and replay them against a
+solver with timing. This allows solvers to be benchmarked without the rest of
+the GPUVerify toolchain, and shows which queries dominate a slow kernel."""
+from __future__ import print_function
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+import timeit
+
+from GPUVerifyScript.smt2_queries import QueryStore, split_log
+
+class Smt2ToolErrorCodes(object):
+  SUCCESS = 0
+  GENERAL_ERROR = 1
+  FILE_ERROR = 2
+
+def readLog(log):
+  with open(log) as f:
+    return split_log(f.read())
+
+def solverCommand(args, filename):
+  if args.solver == "z3":
+    return [args.solver_exe, "-smt2", filename]
+  else:
+    return [args.solver_exe, "--lang", "smt2", filename]
+
+def runQuery(args, filename):
+  """ Run the solver on filename. Returns a pair (result, seconds), where
+      result is the first line printed by the solver, or timeout """
+  # The output goes to a file, as a solver that fills a pipe that is only
+  # read once it finishes would block
+  with tempfile.TemporaryFile(mode = 'w+') as output:
+    start = timeit.default_timer()
+    proc = subprocess.Popen(solverCommand(args, filename), stdout = output,
+      stderr = subprocess.STDOUT, stdin = subprocess.PIPE,
+      universal_newlines = True)
+    while proc.poll() is None:
+      if args.timeout > 0 and timeit.default_timer() - start > args.timeout:
+        proc.kill()
+        proc.wait()
+        return "timeout", timeit.default_timer() - start
+      time.sleep(0.01)
+    end = timeit.default_timer()
+    output.seek(0)
+    lines = output.read().strip().splitlines()
+  return (lines[0].strip() if lines else "error"), end - start
+
+def doSplit(args):
+  store = QueryStore(args.store)
+  for log in args.logs:
+    queries = readLog(log)
+    new = sum(store.add(q, log, n) for n, q in enumerate(queries))
+    print("{}: {} queries, {} new".format(log, len(queries), new))
+  store.save()
+  print("{} distinct queries in {}".format(len(store.index), args.store))
+  return Smt2ToolErrorCodes.SUCCESS
+
+def doReplay(args):
+  """ Replay the queries of the logs given, or of the store if none are given,
+      and print them ordered by the time taken """
+  replays = []
+  if args.logs:
+    seen = set()
+    for log in args.logs:
+      for number, query in enumerate(readLog(log)):
+        if query.key in seen:
+          continue
+        seen.add(query.key)
+        with tempfile.NamedTemporaryFile(mode = 'w', suffix = ".smt2",
+                                         delete = False) as f:
+          f.write(query.text)
+        try:
+          result, seconds = runQuery(args, f.name)
+        finally:
+          os.remove(f.name)
+        replays.append((seconds, result, query.key,
+                        "{}:{} {}".format(log, number, query.vc or "")))
+  else:
+    store = QueryStore(args.store)
+    for key in sorted(store.index):
+      result, seconds = runQuery(args, store.path(key))
+      origins = store.index[key]
+      replays.append((seconds, result, key, "{} {} (seen {} times)".format(
+        origins[0]["log"], origins[0]["vc"] or "", len(origins))))
+
+  total = sum(r[0] for r in replays)
+  print("Replayed {} queries with {} in {:.3f} secs".format(len(replays),
+    args.solver, total))
+  replays.sort(reverse = True)
+  for seconds, result, key, origin in replays[:args.top or len(replays)]:
+    share = 100.0 * seconds / total if total > 0 else 0.0
+    print("{:10.3f} {:>6.1f}% {:<8} {} {}".format(seconds, share, result,
+      key[:12], origin))
+
+  if args.csv_file:
+    with open(args.csv_file, "w") as f:
+      for seconds, result, key, origin in replays:
+        print(",".join([key, "%.3f" % seconds, result]), file = f)
+  return Smt2ToolErrorCodes.SUCCESS
+
+def main(arg):
+  parser = argparse.ArgumentParser(description = __doc__)
+  commands = parser.add_subparsers(dest = "command")
+
+  split = commands.add_parser("split", help = "Add the queries in the logs " +
+    "to a store, skipping queries that are already there")
+  split.add_argument("logs", nargs = '+', help = "SMT-LIB logs to split")
+  split.add_argument("--store", required = True,
+    help = "Directory to store the queries in")
+
+  replay = commands.add_parser("replay", help = "Replay the queries in the " +
+    "logs, or all queries in a store, and list them by the time taken")
+  replay.add_argument("logs", nargs = '*', help = "SMT-LIB logs to replay")
+  replay.add_argument("--store", help = "Replay the queries in this store " +
+    "when no logs are given")
+  replay.add_argument("--solver", choices = ["z3", "cvc4"], default = "z3",
+    help = "Solver to replay the queries with (default: %(default)s)")
+  replay.add_argument("--solver-exe", default = None,
+    help = "Solver executable (default: the one used by GPUVerify)")
+  replay.add_argument("--timeout", type = int, default = 300,
+    help = "Allow each query at most this many seconds; 0 disables the " +
+    "timeout (default: %(default)s)")
+  replay.add_argument("--top", type = int, default = None,
+    help = "Only list this many of the slowest queries")
+  replay.add_argument("--csv-file", default = None,
+    help = "Also write the timing of each query to this file as CSV")
+
+  args = parser.parse_args(arg)
+
+  if args.command == "split":
+    return doSplit(args)
+  elif args.command == "replay":
+    if not args.logs and not args.store:
+      parser.error("replay needs logs or --store")
+    if args.store and not os.path.isdir(args.store):
+      print("\"{}\" is not a query store".format(args.store), file = sys.stderr)
+      return Smt2ToolErrorCodes.FILE_ERROR
+    if args.solver_exe is None:
+      import gvfindtools
+      gvfindtools.init(sys.path[0])
+      args.solver_exe = os.path.join(gvfindtools.z3BinDir if args.solver == \
+        "z3" else gvfindtools.cvc4BinDir, args.solver + ".exe")
+    try:
+      return doReplay(args)
+    except OSError as e:
+      print("Error while invoking {} : {}".format(args.solver_exe, str(e)),
+            file = sys.stderr)
+      return Smt2ToolErrorCodes.GENERAL_ERROR
+  else:
+    parser.print_help()
+    return Smt2ToolErrorCodes.GENERAL_ERROR
+
+if __name__ == "__main__":
+  sys.exit(main(sys.argv[1:]))
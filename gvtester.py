@@ -15,6 +15,8 @@ import subprocess
 import pickle
 import time
 import string
+import shutil
+import tempfile
 try:
     # Python 2.x
     from Queue import Queue
@@ -122,12 +124,16 @@ class GPUVerifyTestKernel(object):
                 raise KernelParseError(2,self.path,"Second Line should start with \"//\" and then optionally space seperate arguments to pass to GPUVerify")
 
             self.gpuverifyCmdArgs = cmdArgs[2:].strip().split() #Split on spaces
+            #A ';' separates the arguments of successive runs of GPUVerify, e.g.
+            #to check that a run uses a cache written by an earlier run. The
+            #expected outcome and regexes apply to the last run
 
             #Perform variable substitution in commandline arguments (e.g. ${KERNEL_DIR})
 
             #This defines the substitution mapping, we can easily add more :)
             cmdArgsSubstitution = {
-            'KERNEL_DIR':os.path.dirname(self.path) 
+            'KERNEL_DIR':os.path.dirname(self.path),
+            'TEMP_DIR':'${TEMP_DIR}' # Substituted when the test is run
             }
 
             for index in range(0,len(self.gpuverifyCmdArgs)):
@@ -173,7 +179,12 @@ class GPUVerifyTestKernel(object):
             #Add additional GPUVerify command line args
             if additionalOptions != None:
               logging.debug("Adding additional command line arguments" + str(additionalOptions))
-              self.gpuverifyCmdArgs.extend(additionalOptions)
+              cmdArgs=[]
+              for arg in self.gpuverifyCmdArgs:
+                if arg == ';':
+                  cmdArgs.extend(additionalOptions)
+                cmdArgs.append(arg)
+              self.gpuverifyCmdArgs=cmdArgs + additionalOptions
 
 
     def run(self):
@@ -185,25 +196,39 @@ class GPUVerifyTestKernel(object):
         """
         threadStr='[' + threading.currentThread().name + '] '
 
-        cmdLine=[sys.executable, GPUVerifyExecutable] \
-            + self.gpuverifyCmdArgs + [self.path]
+        #Files the test writes, e.g. with --json-errors, go to a temporary
+        #directory of the run (${TEMP_DIR}) so they are not left in the testsuite
+        tempDir=tempfile.mkdtemp(prefix='gvtester')
+        runs=[[]]
+        for arg in self.gpuverifyCmdArgs:
+            if arg == ';':
+                runs.append([])
+            else:
+                runs[-1].append(string.Template(arg).safe_substitute(TEMP_DIR=tempDir))
         try:
             logging.info(threadStr + "Running test " + self.path)
             logging.debug(self) # show pre test information
 
-            processInstance=subprocess.Popen(cmdLine,
-                                             stdout=subprocess.PIPE,
-                                             stderr=subprocess.PIPE,
-                                             stdin=subprocess.PIPE,
-                                             close_fds=(os.name == 'posix'),
-                                             cwd=os.path.dirname(self.path)
-                                            )
-            stdout, stderr = processInstance.communicate() #Allow program to run and wait for it to exit.
+            for runArgs in runs:
+                cmdLine=[sys.executable, GPUVerifyExecutable] + runArgs + [self.path]
+                processInstance=subprocess.Popen(cmdLine,
+                                                 stdout=subprocess.PIPE,
+                                                 stderr=subprocess.PIPE,
+                                                 stdin=subprocess.PIPE,
+                                                 close_fds=(os.name == 'posix'),
+                                                 cwd=os.path.dirname(self.path)
+                                                )
+                stdout, stderr = processInstance.communicate() #Allow program to run and wait for it to exit.
+                #An earlier run with an unexpected outcome decides the test
+                if processInstance.returncode != self.expectedReturnCode:
+                    break
 
         except KeyboardInterrupt:
             logging.error("Received keyboard interrupt. Attempting to kill GPUVerify process")
             processInstance.kill()
             raise
+        finally:
+            shutil.rmtree(tempDir, ignore_errors=True)
 
         # Handle byte/str issue in python 3.
         stdout = stdout.decode()
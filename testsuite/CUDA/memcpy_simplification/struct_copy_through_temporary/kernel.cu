@@ -0,0 +1,16 @@
+//pass
+//--gridDim=1 --blockDim=32 --no-inline --simplify-memcpy --verbose
+//memcpy simplification: 1 of 2 memcpy call\(s\) remain
+
+//The copy through tmp becomes a single memcpy from in to out.
+
+typedef struct {
+  short x;
+  short y;
+  char z;
+} s_t;
+
+__global__ void k(s_t *in, s_t *out) {
+  s_t tmp = in[threadIdx.x];
+  out[threadIdx.x] = tmp;
+}
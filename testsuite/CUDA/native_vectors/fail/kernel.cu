@@ -0,0 +1,7 @@
+//xfail:NOT_ALL_VERIFIED
+//--blockDim=64 --gridDim=64 --no-inline --native-vectors
+//kernel.cu: error: possible write-write race on p
+
+__global__ void foo(float4 *p) {
+  p[blockIdx.x] = make_float4(threadIdx.x);
+}
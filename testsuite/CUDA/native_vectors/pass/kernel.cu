@@ -0,0 +1,9 @@
+//pass
+//--blockDim=64 --gridDim=64 --no-inline --native-vectors
+
+__global__ void foo(float4 *p, int2 *q) {
+  float4 v = p[blockIdx.x*blockDim.x + threadIdx.x];
+  float4 w = v + v;
+  p[blockIdx.x*blockDim.x + threadIdx.x] = w * 2.0f;
+  q[blockIdx.x*blockDim.x + threadIdx.x] = make_int2(threadIdx.x, 0);
+}
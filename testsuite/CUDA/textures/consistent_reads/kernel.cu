@@ -0,0 +1,12 @@
+//pass
+//--blockDim=64 --gridDim=16 --no-inline
+
+texture<float, cudaTextureType2D, cudaReadModeElementType> tex;
+
+__global__ void foo(float *A, float x, float y)
+{
+    float a = tex2D(tex, x, y);
+    float b = tex2D(tex, x, y);
+    __assert(a == b);
+    A[blockIdx.x*blockDim.x + threadIdx.x] = a;
+}
@@ -0,0 +1,14 @@
+//xfail:NOT_ALL_VERIFIED
+//--blockDim=64 --gridDim=16 --no-inline
+//kernel.cu:[\d]+:[\d]+:[\s]+error:[\s]+this assertion might not hold
+
+texture<int, cudaTextureType1D, cudaReadModeElementType> texA;
+texture<int, cudaTextureType1D, cudaReadModeElementType> texB;
+
+__global__ void foo(int *A)
+{
+    int i = blockIdx.x*blockDim.x + threadIdx.x;
+    // The textures may hold different contents, so their reads need not agree
+    __assert(tex1Dfetch(texA, i) == tex1Dfetch(texB, i));
+    A[i] = tex1Dfetch(texA, i);
+}
@@ -0,0 +1,10 @@
+//pass
+//--blockDim=64 --gridDim=16 --no-inline
+
+texture<uchar4, cudaTextureType1D, cudaReadModeNormalizedFloat> tex;
+
+__global__ void foo(float4 *A)
+{
+    int i = blockIdx.x*blockDim.x + threadIdx.x;
+    A[i] = tex1Dfetch(tex, i);
+}
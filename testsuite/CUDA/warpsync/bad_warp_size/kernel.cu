@@ -0,0 +1,20 @@
+//xfail:NOT_ALL_VERIFIED
+//--blockDim=1024 --gridDim=64 --warp-sync=32 --no-inline
+//kernel.cu:[\d]+:[\d]+:[\s]+error:[\s]+possible [a-z-]+ race on A
+
+#include <cuda.h>
+
+// A scan across 64 threads that relies on a 64-wide warp, as scan_warp_64
+// does, checked with a 32-wide warp: the two halves are not synchronised
+__global__ void scan (int* A)
+{
+	int tid = blockIdx.x*blockDim.x + threadIdx.x;
+	unsigned int lane = threadIdx.x & 63;
+
+	if (lane >= 1) A[tid] = A[tid - 1] + A[tid];
+	if (lane >= 2) A[tid] = A[tid - 2] + A[tid];
+	if (lane >= 4) A[tid] = A[tid - 4] + A[tid];
+	if (lane >= 8) A[tid] = A[tid - 8] + A[tid];
+	if (lane >= 16) A[tid] = A[tid - 16] + A[tid];
+	if (lane >= 32) A[tid] = A[tid - 32] + A[tid];
+}
@@ -0,0 +1,20 @@
+//pass
+//--blockDim=[32,32] --gridDim=[16,16] --warp-sync=32 --no-inline
+
+#include <cuda.h>
+
+__global__ void warp_sums (int* A, int* sums)
+{
+	__shared__ int tile[1024];
+
+	tile[__linear_tid] = A[__linear_tid];
+
+	if (__lane_id < 16) tile[__linear_tid] += tile[__linear_tid + 16];
+	if (__lane_id < 8) tile[__linear_tid] += tile[__linear_tid + 8];
+	if (__lane_id < 4) tile[__linear_tid] += tile[__linear_tid + 4];
+	if (__lane_id < 2) tile[__linear_tid] += tile[__linear_tid + 2];
+	if (__lane_id < 1) tile[__linear_tid] += tile[__linear_tid + 1];
+
+	if (__lane_id == 0)
+		sums[(blockIdx.y*gridDim.x + blockIdx.x)*32 + __warp_id] = tile[__linear_tid];
+}
@@ -0,0 +1,17 @@
+//pass
+//--blockDim=1024 --gridDim=64 --warp-sync=64 --no-inline
+
+#include <cuda.h>
+
+__global__ void scan (int* A)
+{
+	int tid = blockIdx.x*blockDim.x + threadIdx.x;
+	unsigned int lane = threadIdx.x & 63;
+
+	if (lane >= 1) A[tid] = A[tid - 1] + A[tid];
+	if (lane >= 2) A[tid] = A[tid - 2] + A[tid];
+	if (lane >= 4) A[tid] = A[tid - 4] + A[tid];
+	if (lane >= 8) A[tid] = A[tid - 8] + A[tid];
+	if (lane >= 16) A[tid] = A[tid - 16] + A[tid];
+	if (lane >= 32) A[tid] = A[tid - 32] + A[tid];
+}
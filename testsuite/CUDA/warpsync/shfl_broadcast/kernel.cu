@@ -0,0 +1,13 @@
+//pass
+//--blockDim=64 --gridDim=256 --warp-sync=64 --no-inline
+
+#include <cuda.h>
+
+__global__ void broadcast (int* A, int* offsets)
+{
+	__shared__ int buffer[128];
+
+	int base = __shfl(offsets[blockIdx.x], 0);
+
+	buffer[(base & 63) + __lane_id] = A[blockIdx.x*blockDim.x + threadIdx.x];
+}
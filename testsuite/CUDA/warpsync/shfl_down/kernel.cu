@@ -0,0 +1,21 @@
+//pass
+//--blockDim=1024 --gridDim=64 --warp-sync=32 --no-inline
+
+#include <cuda.h>
+
+__global__ void reduce (int* A, int* sums)
+{
+	int x = A[blockIdx.x*blockDim.x + threadIdx.x];
+	int y = __shfl_down(x, 1);
+
+	__assert(__implies(__same_warp & __lane_id < 31 & __other_int(__lane_id) == __lane_id + 1, y == __other_int(x)));
+	__assert(__implies(__lane_id == 31, y == x));
+
+	y += __shfl_down(y, 2);
+	y += __shfl_down(y, 4);
+	y += __shfl_down(y, 8);
+	y += __shfl_down(y, 16);
+
+	if (__lane_id == 0)
+		sums[blockIdx.x*32 + __warp_id] = y;
+}
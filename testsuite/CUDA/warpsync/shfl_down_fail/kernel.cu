@@ -0,0 +1,13 @@
+//xfail:NOT_ALL_VERIFIED
+//--blockDim=1024 --gridDim=64 --warp-sync=32 --no-inline
+//kernel.cu:[\d]+:[\d]+:[\s]+error:[\s]+this assertion might not hold
+
+#include <cuda.h>
+
+__global__ void reduce (int* A)
+{
+	int x = A[blockIdx.x*blockDim.x + threadIdx.x];
+	int y = __shfl_down(x, 1, 16);
+
+	__assert(__implies(__same_warp & __other_int(__lane_id) == __lane_id + 1, y == __other_int(x)));
+}
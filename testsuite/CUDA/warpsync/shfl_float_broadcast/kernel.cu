@@ -0,0 +1,14 @@
+//pass
+//--blockDim=64 --gridDim=256 --warp-sync=64 --no-inline
+
+#include <cuda.h>
+
+__global__ void broadcast (int* A, float* offsets)
+{
+	__shared__ int buffer[128];
+
+	// Every lane obtains the bits of lane 0's value, so the offsets agree
+	float base = __shfl(offsets[blockIdx.x], 0);
+
+	buffer[((int)base & 63) + __lane_id] = A[blockIdx.x*blockDim.x + threadIdx.x];
+}
@@ -0,0 +1,9 @@
+//pass
+//--local_size=64 --num_groups=8 --bounds-check-job
+
+__kernel void foo(__global int *A) {
+  local int L[256];
+  for (unsigned i = get_local_id(0); i < 256; i += get_local_size(0)) {
+    L[i] = A[get_group_id(0)*256 + i];
+  }
+}
@@ -0,0 +1,10 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=8 --bounds-check-job
+//kernel.cl:8:[\d]+:[\s]+error:[\s]+possible array out-of-bounds access on array L
+
+__kernel void foo(__global int *A) {
+  local int L[256];
+  for (unsigned i = get_local_id(0); i <= 256; i += get_local_size(0)) {
+    L[i] = A[get_group_id(0)*256 + i];
+  }
+}
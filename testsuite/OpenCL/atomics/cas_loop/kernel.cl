@@ -0,0 +1,15 @@
+//pass
+//--local_size=64 --num_groups=12 --no-inline --verbose
+//Adding [1-9][\d]* candidate\(s\) to compare-and-swap loops
+
+__kernel void push(__global volatile unsigned *tail, __global unsigned *counts) {
+    unsigned old = atomic_add(tail, 0);
+    unsigned assumed;
+
+    do {
+        assumed = old;
+        old = atomic_cmpxchg(tail, assumed, assumed + 1);
+    } while (old != assumed);
+
+    counts[get_global_id(0)] = old;
+}
@@ -0,0 +1,15 @@
+//pass
+//--local_size=64 --num_groups=12 --no-inline --verbose
+//Adding [1-9][\d]* candidate\(s\) to compare-and-swap loops
+#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable
+
+__kernel void maximum(__local volatile long *m, __global long *values) {
+    long value = values[get_global_id(0)];
+    long old = atom_add(m, 0);
+    long assumed;
+
+    do {
+        assumed = old;
+        old = atom_cmpxchg(m, assumed, value > assumed ? value : assumed);
+    } while (old != assumed);
+}
@@ -0,0 +1,15 @@
+//pass
+//--local_size=64 --num_groups=12 --no-inline --omit-infer=accessBreak --omit-infer=accessedOffsetsSatisfyPredicates --omit-infer=accessedOffsetInRangeCTimesLid --omit-infer=accessedOffsetInRangeCTimesGid --verbose
+//Adding [1-9][\d]* candidate\(s\) to compare-and-swap loops
+
+// Without the other access invariants, only the compare-and-swap loop
+// candidate states that the accesses logged in the loop are at the offset the
+// thread writes, see cas_loop_omitted
+__kernel void claim(__global volatile unsigned *lock, __global unsigned *data) {
+    unsigned old;
+
+    do {
+        data[get_global_id(0)] = get_global_id(0);
+        old = atomic_cmpxchg(lock, 0, 1);
+    } while (old != 0);
+}
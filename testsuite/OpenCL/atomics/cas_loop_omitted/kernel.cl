@@ -0,0 +1,13 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=12 --no-inline --omit-infer=accessBreak --omit-infer=accessedOffsetsSatisfyPredicates --omit-infer=accessedOffsetInRangeCTimesLid --omit-infer=accessedOffsetInRangeCTimesGid --omit-infer=casLoop
+//kernel.cl:[\d]+:[\d]+:[\s]+error:[\s]+possible write-write race on data
+
+// As cas_loop_needed, without the compare-and-swap loop candidate
+__kernel void claim(__global volatile unsigned *lock, __global unsigned *data) {
+    unsigned old;
+
+    do {
+        data[get_global_id(0)] = get_global_id(0);
+        old = atomic_cmpxchg(lock, 0, 1);
+    } while (old != 0);
+}
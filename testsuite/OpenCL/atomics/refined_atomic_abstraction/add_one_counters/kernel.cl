@@ -0,0 +1,14 @@
+//pass
+//--local_size=64 --num_groups=12 --atomic-counters --no-inline
+
+__kernel void foo(__global unsigned *globalCounter, __local unsigned *localCounter, __global float *globalArray, __local float *localArray) {
+
+    unsigned globalIndex = atomic_add(globalCounter, 1);
+
+    unsigned localIndex = atom_add(localCounter, 1);
+
+    globalArray[globalIndex] = get_global_id(0);
+
+    localArray[localIndex] = get_local_id(0);
+
+}
@@ -0,0 +1,9 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=12 --atomic-counters --no-inline
+//kernel.cl:8
+
+__kernel void foo(__global unsigned *globalCounter, __global float *globalArray) {
+    unsigned globalIndex = atomic_add(globalCounter, 2);
+
+    globalArray[globalIndex] = get_global_id(0);
+}
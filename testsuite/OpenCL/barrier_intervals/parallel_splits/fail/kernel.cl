@@ -0,0 +1,14 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=16 --num_groups=16 --parallel-splits=4
+//kernel.cl: error: possible read-write race on p
+
+#define tid get_local_id(0)
+
+__kernel void simple_kernel(__local int* p)
+{
+    p[tid] = tid;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    p[tid] = tid;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    p[tid] = p[(tid + 1) % 16];
+}
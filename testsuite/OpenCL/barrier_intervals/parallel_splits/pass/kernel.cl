@@ -0,0 +1,16 @@
+//pass
+//--local_size=16 --num_groups=16 --parallel-splits=4 --verbose
+//Splitting at 3 barrier\(s\)
+
+#define tid get_local_id(0)
+
+__kernel void simple_kernel(__local int* p, __global int* q)
+{
+    p[tid] = tid;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    p[tid] = p[(tid + 1) % 16];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    p[(tid + 1) % 16] = tid;
+    barrier(CLK_LOCAL_MEM_FENCE);
+    q[get_global_id(0)] = p[tid];
+}
@@ -0,0 +1,11 @@
+//pass
+//--local_size=16 --num_groups=1 --incremental-loop-unwind=4 --no-inline
+//Use --loop-unwind=N with N > 4 to search for deeper bugs
+
+__kernel void foo(__local int* A) {
+
+    for(int i = 0; i < 100; i++) {
+        A[get_local_id(0)] = i;
+    }
+
+}
@@ -0,0 +1,13 @@
+//pass
+//--local_size=1024 --num_groups=1024 --no-inline --houdini-cache=${TEMP_DIR}/kernel.houdini ; --local_size=1024 --num_groups=1024 --no-inline --houdini-cache=${TEMP_DIR}/kernel.houdini --verbose
+//Houdini cache: [1-9][\d]* of [1-9][\d]* candidates were proven and 0 refuted by previous runs
+
+__kernel void example(__local int * A) {
+
+    for(unsigned i = 0; i < 100; i++) {
+        for(unsigned j = 0; j < (1 << 16); j += 16) {
+            __assert((j % 16) == 0);
+        }
+    }
+
+}
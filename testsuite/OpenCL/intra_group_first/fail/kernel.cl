@@ -0,0 +1,13 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=16 --intra-group-first --verbose
+//error: possible [a-z-]+ race on B
+//Not checking inter-group races, as the intra-group check did not pass
+
+__kernel void foo(__global int* A, __local int* B) {
+
+    for(int i = 0; i < 8; i++) {
+        B[get_local_id(0)] = A[get_global_id(0)] + i;
+        A[get_global_id(0)] = B[63 - get_local_id(0)];
+    }
+
+}
@@ -0,0 +1,7 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=8 --json-errors=${TEMP_DIR}/kernel.json
+//kernel.cl:[\d]+:[\d]+:[\s]+error:[\s]+possible write-write race on A
+
+__kernel void foo(__global int *A) {
+  A[get_global_id(0) / 2] = get_global_id(0);
+}
@@ -0,0 +1,16 @@
+//pass
+//--local_size=1024 --num_groups=24 --no-infer --adaptive-k-induction=4 --parallel-k-induction
+
+__kernel void foo(int a, int b, int c) {
+    __requires(a != b);
+    __requires(a != c);
+    __requires(b != c);
+
+    for(int i = 0; __invariant(a != b), i < 100; i++) {
+        int temp = a;
+        a = b;
+        b = c;
+        c = temp;
+    }
+    __assert(a != b);
+}
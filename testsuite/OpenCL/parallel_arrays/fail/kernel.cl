@@ -0,0 +1,12 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=16 --parallel-arrays=2
+//error: possible [a-z-]+ race on B
+//A[\s]+:[\s]+verified
+//B[\s]+:[\s]+NOT_ALL_VERIFIED
+
+__kernel void foo(__global int* A, __local int* B) {
+
+    B[get_local_id(0)] = A[get_global_id(0)];
+    A[get_global_id(0)] = B[63 - get_local_id(0)];
+
+}
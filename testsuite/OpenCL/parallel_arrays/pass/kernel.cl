@@ -0,0 +1,12 @@
+//pass
+//--local_size=64 --num_groups=16 --parallel-arrays=2
+//A[\s]+:[\s]+verified
+//B[\s]+:[\s]+verified
+
+__kernel void foo(__global int* A, __local int* B) {
+
+    B[get_local_id(0)] = A[get_global_id(0)];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    A[get_global_id(0)] = B[63 - get_local_id(0)];
+
+}
@@ -0,0 +1,11 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=4 --race-instrumenter=auto --verbose
+//error: possible [a-z-]+ race on B
+//Chose race instrumenter original
+
+__kernel void foo(__global int* A, __local int* B) {
+
+    B[get_local_id(0)] = A[get_global_id(0)];
+    A[get_global_id(0)] = B[(get_local_id(0) + 1) % 64];
+
+}
@@ -0,0 +1,15 @@
+//pass
+//--local_size=64 --num_groups=4 --race-instrumenter=auto --verbose
+//Chose race instrumenter watchdog-multiple
+
+__kernel void foo(__global int* A, __global int* C) {
+
+    size_t i = get_global_id(0);
+    for(int j = 0; j < 4; j++) {
+        A[i] = A[i] + C[i];
+        C[i] = C[i] + A[i];
+        A[i] = A[i] * C[i];
+        C[i] = C[i] * A[i];
+    }
+
+}
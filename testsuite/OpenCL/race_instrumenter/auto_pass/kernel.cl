@@ -0,0 +1,14 @@
+//pass
+//--local_size=64 --num_groups=4 --race-instrumenter=auto --verbose
+//Chose race instrumenter watchdog-single
+
+__kernel void foo(__global int* A, __local int* B) {
+
+    for(int i = 0; i < 4; i++) {
+        B[get_local_id(0)] = A[get_global_id(0)] + i;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        A[get_global_id(0)] = B[(get_local_id(0) + 1) % 64];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+}
@@ -0,0 +1,13 @@
+//pass
+//--local_size=64 --num_groups=4 --benchmark-race-instrumenters
+//original[\s]+:[\s]+SUCCESS
+//watchdog-single[\s]+:[\s]+SUCCESS
+//watchdog-multiple[\s]+:[\s]+SUCCESS
+
+__kernel void foo(__global int* A, __local int* B) {
+
+    B[get_local_id(0)] = A[get_global_id(0)];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    A[get_global_id(0)] = B[(get_local_id(0) + 1) % 64];
+
+}
@@ -0,0 +1,9 @@
+//xfail:COMMAND_LINE_ERROR
+//--local_size=64 --num_groups=4 --benchmark-race-instrumenters --houdini-cache=${TEMP_DIR}/kernel.houdini
+//--benchmark-race-instrumenters cannot be combined with --houdini-cache
+
+__kernel void foo(__global int* A) {
+
+    A[get_global_id(0)] = get_global_id(0);
+
+}
@@ -0,0 +1,9 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=64 --elide-read-only-arrays
+//kernel.cl: error: possible [a-z-]+ race on A
+
+__kernel void foo(__global int *A, __global const int *table) {
+  int x = table[get_global_id(0)];
+  A[get_global_id(0)] = x;
+  x = A[get_global_id(0) + 1];
+}
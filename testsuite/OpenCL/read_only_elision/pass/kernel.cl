@@ -0,0 +1,10 @@
+//pass
+//--local_size=64 --num_groups=64 --elide-read-only-arrays --verbose
+//Read-only arrays elided from race checking: .*table
+
+__kernel void foo(__global int *A, __global const int *table, __global int *B) {
+  __local int C[64];
+
+  C[get_local_id(0)] = table[B[get_global_id(0)]];
+  A[get_global_id(0)] = C[get_local_id(0)] + table[get_local_id(0)];
+}
@@ -0,0 +1,8 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=8 --replay
+//kernel.cl:[\d]+:[\d]+:[\s]+error:[\s]+possible write-write race on A
+//Replay of race at kernel.cl:[\d]+:[\d]+: confirmed \(write by thread 1 and write by thread 2 of A\[
+
+__kernel void foo(__global int *A) {
+  A[get_global_id(0) / 2] = get_global_id(0);
+}
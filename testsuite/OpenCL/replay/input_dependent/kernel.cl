@@ -0,0 +1,11 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=8 --replay
+//kernel.cl:[\d]+:[\d]+:[\s]+error:[\s]+possible write-write race on A
+//Replay of race at kernel.cl:[\d]+:[\d]+: inconclusive \(the threads read memory they did not write, of B
+
+__kernel void foo(__global int *A, __global int *B) {
+  // B is never written, so whether the race occurs depends on the input
+  if (B[get_global_id(0)] != 0) {
+    A[0] = get_global_id(0);
+  }
+}
@@ -0,0 +1,13 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=8 --no-infer --replay
+//kernel.cl:[\d]+:[\d]+:[\s]+error:[\s]+possible write-write race on A
+//Replay of race at kernel.cl:[\d]+:[\d]+: not reproduced
+
+__kernel void foo(__global int *A) {
+  int j = 0;
+  // Without invariants, j is arbitrary after the loop; it is always 0
+  for (int i = 0; i < 100; i++) {
+    j = j * 2;
+  }
+  A[get_global_id(0) + j] = 1;
+}
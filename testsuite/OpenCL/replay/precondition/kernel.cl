@@ -0,0 +1,10 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=8 --replay
+//kernel.cl:[\d]+:[\d]+:[\s]+error:[\s]+possible write-write race on A
+//Replay of race at kernel.cl:[\d]+:[\d]+: inconclusive \(a precondition of the kernel depends on the initial values of B
+
+__kernel void foo(__global int *A, __global int *B) {
+  __requires(B[0] != 0);
+  // The race needs B[0] != 0, which reading B as zero would miss
+  A[B[0] == 0 ? get_global_id(0) : 0] = get_global_id(0);
+}
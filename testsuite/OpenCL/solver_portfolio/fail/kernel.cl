@@ -0,0 +1,10 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=16 --solver=portfolio
+//error: possible [a-z-]+ race on B
+
+__kernel void foo(__global int* A, __local int* B) {
+
+    B[get_local_id(0)] = A[get_global_id(0)];
+    A[get_global_id(0)] = B[63 - get_local_id(0)];
+
+}
@@ -0,0 +1,14 @@
+//pass
+//--local_size=64 --num_groups=16 --solver=portfolio --verbose
+//Using the result of (z3|cvc4)
+
+__kernel void foo(__global int* A, __local int* B) {
+
+    for(int i = 0; i < 8; i++) {
+        B[get_local_id(0)] = A[get_global_id(0)] + i;
+        barrier(CLK_LOCAL_MEM_FENCE);
+        A[get_global_id(0)] = B[63 - get_local_id(0)];
+        barrier(CLK_LOCAL_MEM_FENCE);
+    }
+
+}
@@ -0,0 +1,9 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=1 --only-divergence --symmetry-reduction
+//kernel.cl:7:[\d]+:[\s]+error:[\s]+barrier may be reached by non-uniform control flow
+
+__kernel void foo(__local int* B) {
+  if (get_local_id(0) < 32) {
+    barrier(CLK_LOCAL_MEM_FENCE);
+  }
+}
@@ -0,0 +1,14 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=[8,8,4] --num_groups=[16,16,8] --symmetry-reduction --verbose
+//error: possible [a-z-]+ race on B
+//Not applying symmetry reduction: races are only checked
+
+__kernel void foo(__global float* A, __local float* B) {
+
+    size_t lid = (get_local_id(2) * 8 + get_local_id(1)) * 8 + get_local_id(0);
+    size_t gid = (get_global_id(2) * 128 + get_global_id(1)) * 128 + get_global_id(0);
+
+    B[lid] = A[gid];
+    A[gid] = B[255 - lid];
+
+}
@@ -0,0 +1,10 @@
+//xfail:NOT_ALL_VERIFIED
+//--local_size=64 --num_groups=1 --symmetry-reduction --verbose
+//kernel.cl:[\d]+:[\d]+:[\s]+error:[\s]+possible [a-z-]+ race on B
+//Not applying symmetry reduction: races are only checked
+
+__kernel void foo(__local int* B) {
+  int lid = get_local_id(0);
+  int x = lid > 0 ? B[lid - 1] : 0;
+  B[lid] = x;
+}
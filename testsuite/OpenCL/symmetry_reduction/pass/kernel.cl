@@ -0,0 +1,14 @@
+//pass
+//--local_size=[8,8,4] --num_groups=[16,16,8] --symmetry-reduction --only-divergence --verbose
+//Ordering the two threads by [a-z_, ]*local_id_x
+
+__kernel void foo(__global float* A, __local float* B) {
+
+    size_t lid = (get_local_id(2) * 8 + get_local_id(1)) * 8 + get_local_id(0);
+    size_t gid = (get_global_id(2) * 128 + get_global_id(1)) * 128 + get_global_id(0);
+
+    B[lid] = A[gid];
+    barrier(CLK_LOCAL_MEM_FENCE);
+    A[gid] = B[255 - lid];
+
+}
@@ -0,0 +1,13 @@
+//pass
+//--local_size=64 --num_groups=16 --show-uniformity --no-inline
+//Uniformity analysis:
+//uniform branches \([1-9][\d]* of [\d]+\)
+//[\d]+ of [\d]+ variable\(s\) need no copy for the second thread
+
+__kernel void foo(__global float* A, int n) {
+
+    for (int i = 0; i < n; i++) {
+        A[i * get_global_size(0) + get_global_id(0)] *= 2.0f;
+    }
+
+}
@@ -0,0 +1,7 @@
+//pass
+//--local_size=64 --num_groups=64 --no-inline --native-vectors
+
+__kernel void foo(__global float4* p, __global float4* q) {
+  float4 v = p[get_global_id(0)];
+  q[get_global_id(0)] = sqrt(v) + pow(v, v);
+}
@@ -0,0 +1,87 @@
+"""Unit tests of parse_error_report, on error reports captured from the
+BoogieDriver. Run with: python -m unittest discover testsuite/python"""
+
+import os
+import sys
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                os.pardir, os.pardir))
+
+from GPUVerifyScript.error_report import parse_error_report
+
+opencl_race = """
+kernel.cl:6:27: error: possible write-write race on A[32]:
+
+Write by work item 65 with local id 1 in work group 1, kernel.cl:6:27:
+  A[get_global_id(0) / 2] = get_global_id(0);
+
+Write by work item 64 with local id 0 in work group 1, kernel.cl:6:27:
+  A[get_global_id(0) / 2] = get_global_id(0);
+
+Bitwise values of parameters of 'foo':
+  n = 0x00000040 (64)
+
+GPUVerify kernel analyser finished with 0 verified, 1 error
+"""
+
+cuda_race = """
+kernel.cu:9:21: error: possible read-write race on A[7] (bytes 28..31):
+
+Read by thread (7, 0, 0) in thread block (0, 1) (global id (7, 1, 0)), kernel.cu:9:12:
+  x = A[threadIdx.x];
+
+Write by thread (8, 0, 0) in thread block (0, 1) (global id (8, 1, 0)), kernel.cu:9:21:
+  A[threadIdx.x - 1] = x;
+"""
+
+barrier_divergence = """
+kernel.cl:10:5: error: barrier may be reached by non-uniform control flow
+    barrier(CLK_LOCAL_MEM_FENCE);
+"""
+
+class ParseErrorReportTest(unittest.TestCase):
+  def test_opencl_race(self):
+    errors = parse_error_report(opencl_race)
+    self.assertEqual(len(errors), 1)
+    error = errors[0]
+    self.assertEqual(error["kind"], "race")
+    self.assertEqual(error["location"],
+                     { "file": "kernel.cl", "line": 6, "column": 27 })
+    self.assertEqual(error["race"],
+                     { "kind": "write-write", "array": "A", "index": "32" })
+    self.assertEqual([a["access"] for a in error["accesses"]],
+                     ["Write", "Write"])
+    self.assertEqual(error["accesses"][0]["thread"],
+                     { "global_id": [65], "local_id": [1], "group_id": [1] })
+    self.assertEqual(error["accesses"][1]["thread"],
+                     { "global_id": [64], "local_id": [0], "group_id": [1] })
+    self.assertEqual(error["accesses"][0]["code"],
+                     "A[get_global_id(0) / 2] = get_global_id(0);")
+    self.assertEqual(error["kernel"], "foo")
+    self.assertEqual(error["parameters"],
+                     { "n": { "value": "0x00000040", "interpretation": "64" } })
+
+  def test_cuda_race(self):
+    errors = parse_error_report(cuda_race)
+    self.assertEqual(len(errors), 1)
+    error = errors[0]
+    self.assertEqual(error["race"], { "kind": "read-write", "array": "A",
+                                      "index": "7", "bytes": "28..31" })
+    self.assertEqual(error["accesses"][0]["thread"],
+      { "local_id": [7, 0, 0], "group_id": [0, 1], "global_id": [7, 1, 0] })
+    self.assertEqual(error["accesses"][1]["location"],
+                     { "file": "kernel.cu", "line": 9, "column": 21 })
+    self.assertNotIn("parameters", error)
+
+  def test_barrier_divergence(self):
+    errors = parse_error_report(barrier_divergence)
+    self.assertEqual([e["kind"] for e in errors], ["barrier_divergence"])
+    self.assertNotIn("accesses", errors[0])
+
+  def test_no_errors(self):
+    self.assertEqual(parse_error_report(
+      "GPUVerify kernel analyser finished with 1 verified, 0 errors\n"), [])
+
+if __name__ == "__main__":
+  unittest.main()